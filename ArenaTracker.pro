@@ -67,11 +67,20 @@ SOURCES += Sources/main.cpp\
     Sources/LibXls/xls.c \
     Sources/LibXls/xlstool.c \
     Sources/Utils/deckstringhandler.cpp \
+    Sources/Utils/cardnameindex.cpp \
+    Sources/Utils/histcache.cpp \
+    Sources/Utils/tierstore.cpp \
+    Sources/Utils/hsvhist.cpp \
     Sources/themehandler.cpp \
     Sources/Utils/libzippp.cpp \
     Sources/synergyhandler.cpp \
     Sources/Synergies/draftitemcounter.cpp \
     Sources/Synergies/statsynergies.cpp \
+    Sources/Synergies/cardtags.cpp \
+    Sources/Synergies/draftdeckstate.cpp \
+    Sources/Synergies/draftlookahead.cpp \
+    Sources/Synergies/synergymatcher.cpp \
+    Sources/Synergies/synergyrules.cpp \
     Sources/Widgets/cardlistwindow.cpp \
     Sources/Widgets/hoverlabel.cpp \
     Sources/Widgets/draftmechanicswindow.cpp \
@@ -141,11 +150,20 @@ HEADERS  += Sources/mainwindow.h \
     Sources/LibXls/config.h \
     Sources/constants.h \
     Sources/Utils/deckstringhandler.h \
+    Sources/Utils/cardnameindex.h \
+    Sources/Utils/histcache.h \
+    Sources/Utils/tierstore.h \
+    Sources/Utils/hsvhist.h \
     Sources/themehandler.h \
     Sources/Utils/libzippp.h \
     Sources/synergyhandler.h \
     Sources/Synergies/draftitemcounter.h \
     Sources/Synergies/statsynergies.h \
+    Sources/Synergies/cardtags.h \
+    Sources/Synergies/draftdeckstate.h \
+    Sources/Synergies/draftlookahead.h \
+    Sources/Synergies/synergymatcher.h \
+    Sources/Synergies/synergyrules.h \
     Sources/Widgets/cardlistwindow.h \
     Sources/Widgets/hoverlabel.h \
     Sources/Widgets/draftmechanicswindow.h \
@@ -7,6 +7,53 @@
 bool DeckCard::drawClassColor = false;
 bool DeckCard::drawSpellWeaponColor = false;
 int DeckCard::cardHeight = 35;
+QHash<QString, QSharedPointer<const CardInfo>> DeckCard::cardInfoCache;
+QMutex DeckCard::cardInfoMutex;
+
+
+CardInfo::CardInfo(const QString &code) : code(code)
+{
+    if(!code.isEmpty())
+    {
+        cost = Utility::getCardAttribute(code, "cost").toInt();
+        type = Utility::getTypeFromCode(code);
+        name = Utility::getCardAttribute(code, "name").toString();
+        rarity = Utility::getRarityFromCode(code);
+        cardClass = Utility::getClassFromCode(code);
+        cardRace = Utility::getRaceFromCode(code);
+    }
+    else
+    {
+        cost = -1;
+        type = INVALID_TYPE;
+        name = "unknown";
+        rarity = INVALID_RARITY;
+        cardClass = INVALID_CLASS;
+        cardRace = INVALID_RACE;
+    }
+}
+
+
+//Los CardInfo se crean una sola vez por code, los DeckCard solo copian el puntero.
+QSharedPointer<const CardInfo> DeckCard::getCardInfo(const QString &code)
+{
+    QMutexLocker locker(&cardInfoMutex);
+    QSharedPointer<const CardInfo> cardInfo = cardInfoCache.value(code);
+    if(cardInfo.isNull())
+    {
+        cardInfo = QSharedPointer<const CardInfo>(new CardInfo(code));
+        cardInfoCache.insert(code, cardInfo);
+    }
+    return cardInfo;
+}
+
+
+//Llamar cuando cambie cards.json o el idioma. Los DeckCard existentes mantienen su CardInfo antiguo.
+void DeckCard::clearCardInfoCache()
+{
+    QMutexLocker locker(&cardInfoMutex);
+    cardInfoCache.clear();
+}
 
 
 DeckCard::DeckCard(QString code, bool outsider)
@@ -66,25 +113,7 @@ void DeckCard::resetManaLimits()
 void DeckCard::setCode(QString code)
 {
     this->code = code;
-
-    if(!code.isEmpty())
-    {
-        cost = Utility::getCardAttribute(code, "cost").toInt();
-        type = Utility::getTypeFromCode(code);
-        name = Utility::getCardAttribute(code, "name").toString();
-        rarity = Utility::getRarityFromCode(code);
-        cardClass = Utility::getClassFromCode(code);
-        cardRace = Utility::getRaceFromCode(code);
-    }
-    else
-    {
-        cost = -1;
-        type = INVALID_TYPE;
-        name = "unknown";
-        rarity = INVALID_RARITY;
-        cardClass = INVALID_CLASS;
-        cardRace = INVALID_RACE;
-    }
+    this->info = getCardInfo(code);
 }
 
 
@@ -94,25 +123,7 @@ void DeckCard::setCreatedByCode(QString code)
     if(!this->code.isEmpty()) return;
 
     this->createdByCode = code;
-
-    if(!createdByCode.isEmpty())
-    {
-        cost = Utility::getCardAttribute(code, "cost").toInt();
-        type = Utility::getTypeFromCode(code);
-        name = Utility::getCardAttribute(code, "name").toString();
-        rarity = Utility::getRarityFromCode(code);
-        cardClass = Utility::getClassFromCode(code);
-        cardRace = Utility::getRaceFromCode(code);
-    }
-    else
-    {
-        cost = -1;
-        type = INVALID_TYPE;
-        name = "unknown";
-        rarity = INVALID_RARITY;
-        cardClass = INVALID_CLASS;
-        cardRace = INVALID_RACE;
-    }
+    this->info = getCardInfo(code);
 }
 
 
@@ -176,36 +187,36 @@ QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize
         //Card
         QRectF target;
         QRectF source;
-        if(name == "unknown")                   source = QRectF(0,0,100,25);
-        else if(type==MINION)                   source = QRectF(46,72,100,25);
-        else                                    source = QRectF(46,98,100,25);
-        if(total == 1 && rarity != LEGENDARY)   target = QRectF(113,6,100,25);
-        else                                    target = QRectF(100,6,100,25);
+        if(info->name == "unknown")                 source = QRectF(0,0,100,25);
+        else if(info->type==MINION)                 source = QRectF(46,72,100,25);
+        else                                        source = QRectF(46,98,100,25);
+        if(total == 1 && info->rarity != LEGENDARY) target = QRectF(113,6,100,25);
+        else                                        target = QRectF(100,6,100,25);
 
-        if(name == "unknown")   painter.drawPixmap(target, QPixmap(ThemeHandler::unknownFile()), source);
+        if(info->name == "unknown")   painter.drawPixmap(target, QPixmap(ThemeHandler::unknownFile()), source);
         else    painter.drawPixmap(target, QPixmap(Utility::hscardsPath() + "/" + code + ".png"), source);
 
         //Background and #cards
         painter.setPen(QPen(BLACK));
 
-        if(nameColor!=BLACK)                            painter.setBrush(nameColor);
-        else if(drawRarity)                             painter.setBrush(getRarityColor());
-        else if(outsider)                               painter.setBrush(VIOLET);
-        else if(drawSpellWeaponColor && type==SPELL)    painter.setBrush(YELLOW);
-        else if(drawSpellWeaponColor && type==WEAPON)   painter.setBrush(ORANGE);
-        else                                            painter.setBrush(WHITE);
+        if(nameColor!=BLACK)                                painter.setBrush(nameColor);
+        else if(drawRarity)                                 painter.setBrush(getRarityColor());
+        else if(outsider)                                   painter.setBrush(VIOLET);
+        else if(drawSpellWeaponColor && info->type==SPELL)  painter.setBrush(YELLOW);
+        else if(drawSpellWeaponColor && info->type==WEAPON) painter.setBrush(ORANGE);
+        else                                                painter.setBrush(WHITE);
 
 
         int maxNameLong;
-        if(total == 1 && rarity != LEGENDARY)
+        if(total == 1 && info->rarity != LEGENDARY)
         {
             maxNameLong = 174;
-            painter.drawPixmap(0,0,QPixmap(drawClassColor?ThemeHandler::bgCard1File(cardClass):ThemeHandler::bgCard1File()));
+            painter.drawPixmap(0,0,QPixmap(drawClassColor?ThemeHandler::bgCard1File(info->cardClass):ThemeHandler::bgCard1File()));
         }
         else
         {
             maxNameLong = 155;
-            painter.drawPixmap(0,0,QPixmap(drawClassColor?ThemeHandler::bgCard2File(cardClass):ThemeHandler::bgCard2File()));
+            painter.drawPixmap(0,0,QPixmap(drawClassColor?ThemeHandler::bgCard2File(info->cardClass):ThemeHandler::bgCard2File()));
 
             if(total > 1)
             {
@@ -220,7 +231,7 @@ QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize
 
 
         //Name and mana
-        if(name == "unknown")
+        if(info->name == "unknown")
         {
             font.setPixelSize(14);//10pt
             painter.setPen(QPen(BLACK));
@@ -234,23 +245,23 @@ QPixmap DeckCard::draw(int total, bool drawRarity, QColor nameColor, bool resize
             font.setPixelSize(fontSize);//11pt
 
             QFontMetrics fm(font);
-            int textWide = fm.width(name);
+            int textWide = fm.width(info->name);
             while(textWide>maxNameLong)
             {
                 fontSize--;
                 font.setPixelSize(fontSize);//<11pt
                 fm = QFontMetrics(font);
-                textWide = fm.width(name);
+                textWide = fm.width(info->name);
             }
 
-            Utility::drawShadowText(painter, font, name, 34, 20, false);
+            Utility::drawShadowText(painter, font, info->name, 34, 20, false);
 
             //Mana cost
             if(manaText.isEmpty())
             {
-                int manaSize = cost>9?26:static_cast<int>(18+1.5*cost);
+                int manaSize = info->cost>9?26:static_cast<int>(18+1.5*info->cost);
                 font.setPixelSize(manaSize);//20pt | 14 + cost
-                Utility::drawShadowText(painter, font, QString::number(cost), 13, 20, true);
+                Utility::drawShadowText(painter, font, QString::number(info->cost), 13, 20, true);
             }
             //Custom mana number
             else
@@ -312,10 +323,9 @@ QPixmap DeckCard::drawCustomCard(QString customCode, QString customText)
         QRectF target;
         QRectF source;
 
-        QFileInfo cardFI(Utility::hscardsPath() + "/" + customCode + ".png");
-        if(cardFI.exists())
+        if(Utility::cardImageExists(customCode))
         {
-            if(type==MINION)        source = QRectF(46,72,100,25);
+            if(info->type==MINION)  source = QRectF(46,72,100,25);
             else                    source = QRectF(46,98,100,25);
             if(total == 1)          target = QRectF(113,6,100,25);
             else                    target = QRectF(100,6,100,25);
@@ -348,24 +358,24 @@ QPixmap DeckCard::drawCustomCard(QString customCode, QString customText)
         Utility::drawShadowText(painter, font, customText, 10, 20, false);
 
         //Name
-        int nameWide = fm.width(name);
+        int nameWide = fm.width(info->name);
         int maxNameLong = 194 - customTextWide + (total==1?0:-19);
         while(nameWide>maxNameLong)
         {
             fontSize--;
             font.setPixelSize(fontSize);//<11pt
             fm = QFontMetrics(font);
-            nameWide = fm.width(name);
+            nameWide = fm.width(info->name);
         }
 
         painter.setPen(QPen(BLACK));
 
-        if(outsider)                                    painter.setBrush(VIOLET);
-        else if(drawSpellWeaponColor && type==SPELL)    painter.setBrush(YELLOW);
-        else if(drawSpellWeaponColor && type==WEAPON)   painter.setBrush(ORANGE);
-        else                                            painter.setBrush(WHITE);
+        if(outsider)                                        painter.setBrush(VIOLET);
+        else if(drawSpellWeaponColor && info->type==SPELL)  painter.setBrush(YELLOW);
+        else if(drawSpellWeaponColor && info->type==WEAPON) painter.setBrush(ORANGE);
+        else                                                painter.setBrush(WHITE);
 
-        Utility::drawShadowText(painter, font, name, 14 + customTextWide, 20, false);
+        Utility::drawShadowText(painter, font, info->name, 14 + customTextWide, 20, false);
 
         //#cards
         if(total > 1)
@@ -413,10 +423,10 @@ QPixmap DeckCard::resizeCardHeight(QPixmap &canvas)
 
 QColor DeckCard::getRarityColor()
 {
-    if(rarity == COMMON)            return WHITE;
-    else if(rarity == RARE)         return BLUE;
-    else if(rarity == EPIC)         return VIOLET;
-    else if(rarity == LEGENDARY)    return ORANGE;
+    if(info->rarity == COMMON)          return WHITE;
+    else if(info->rarity == RARE)       return BLUE;
+    else if(info->rarity == EPIC)       return VIOLET;
+    else if(info->rarity == LEGENDARY)  return ORANGE;
     else                            return BLACK;
 }
 
@@ -429,36 +439,36 @@ QString DeckCard::getCode()
 
 CardType DeckCard::getType()
 {
-    return type;
+    return info->type;
 }
 
 
 QString DeckCard::getName()
 {
-    return name;
+    return info->name;
 }
 
 
 int DeckCard::getCost()
 {
-    return cost;
+    return info->cost;
 }
 
 CardRarity DeckCard::getRarity()
 {
-    return rarity;
+    return info->rarity;
 }
 
 
 CardClass DeckCard::getCardClass()
 {
-    return cardClass;
+    return info->cardClass;
 }
 
 
 CardRace DeckCard::getRace()
 {
-    return cardRace;
+    return info->cardRace;
 }
 
 
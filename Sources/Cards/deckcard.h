@@ -4,6 +4,9 @@
 #include <QListWidgetItem>
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QMutex>
+#include <QSharedPointer>
 #include "../constants.h"
 
 
@@ -20,6 +23,23 @@ enum CardRace {INVALID_RACE, BLOODELF, DRAENEI, DWARF, GNOME, GOBLIN, HUMAN, NIG
 enum CardClass {DEMONHUNTER, DRUID, HUNTER, MAGE, PALADIN, PRIEST, ROGUE, SHAMAN, WARLOCK, WARRIOR, INVALID_CLASS, NEUTRAL};
 
 
+//Datos inmutables de una carta, compartidos por todos los DeckCard con el mismo code.
+class CardInfo
+{
+public:
+    CardInfo(const QString &code);
+
+public:
+    const QString code;
+    QString name;
+    CardRarity rarity;
+    CardType type;
+    CardClass cardClass;
+    CardRace cardRace;
+    int cost;
+};
+
+
 class DeckCard
 {
 public:
@@ -37,17 +57,18 @@ public:
 
 
 protected:
-    QString code, name;
-    CardRarity rarity;
-    CardType type;
-    CardClass cardClass;
-    CardRace cardRace;
-    int cost;
+    QString code;
     QString createdByCode;
+    //Puede ser el info de code o de createdByCode
+    QSharedPointer<const CardInfo> info;
 
     static bool drawClassColor, drawSpellWeaponColor;
     static int cardHeight;
 
+private:
+    static QHash<QString, QSharedPointer<const CardInfo>> cardInfoCache;
+    static QMutex cardInfoMutex;
+
 private:
     bool topManaLimit, bottomManaLimit;
     bool outsider;
@@ -80,6 +101,8 @@ public:
     static void setCardHeight(int value);
     static int getCardHeight();
     static int getCardWidth();
+    static QSharedPointer<const CardInfo> getCardInfo(const QString &code);
+    static void clearCardInfoCache();
 };
 
 #endif // DECKCARD_H
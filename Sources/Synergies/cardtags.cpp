@@ -0,0 +1,46 @@
+#include "cardtags.h"
+
+
+CardTags::CardTags()
+{
+    bits = 0;
+}
+
+
+CardTags::CardTags(const QJsonArray &jsonTags)
+{
+    bits = 0;
+    for(const QJsonValue &jsonTag: jsonTags)
+    {
+        CardTag tag = tagFromString(jsonTag.toString());
+        if(tag != TAG_NUM_TAGS)     bits |= (1u << tag);
+    }
+}
+
+
+bool CardTags::contains(CardTag tag) const
+{
+    return (bits & (1u << tag)) != 0;
+}
+
+
+bool CardTags::isEmpty() const
+{
+    return bits == 0;
+}
+
+
+CardTag CardTags::tagFromString(const QString &tagString)
+{
+    static const char *tagStrings[TAG_NUM_TAGS] = {
+        "BATTLECRY", "CANT_ATTACK", "CHARGE", "COMBO", "DEATHRATTLE", "DISCOVER", "DIVINE_SHIELD",
+        "ECHO", "ENRAGED", "FREEZE", "JADE_GOLEM", "LIFESTEAL", "MODULAR", "RUSH", "SECRET",
+        "SILENCE", "STEALTH", "TAUNT", "TWINSPELL", "WINDFURY"
+    };
+
+    for(int i=0; i<TAG_NUM_TAGS; i++)
+    {
+        if(tagString == QLatin1String(tagStrings[i]))   return static_cast<CardTag>(i);
+    }
+    return TAG_NUM_TAGS;
+}
@@ -0,0 +1,41 @@
+#ifndef CARDTAGS_H
+#define CARDTAGS_H
+
+#include <QString>
+#include <QJsonArray>
+
+
+//Tags de cards.json (mechanics/referencedTags) que usan las reglas de sinergias
+enum CardTag {TAG_BATTLECRY, TAG_CANT_ATTACK, TAG_CHARGE, TAG_COMBO, TAG_DEATHRATTLE, TAG_DISCOVER, TAG_DIVINE_SHIELD,
+              TAG_ECHO, TAG_ENRAGED, TAG_FREEZE, TAG_JADE_GOLEM, TAG_LIFESTEAL, TAG_MODULAR, TAG_RUSH, TAG_SECRET,
+              TAG_SILENCE, TAG_STEALTH, TAG_TAUNT, TAG_TWINSPELL, TAG_WINDFURY, TAG_NUM_TAGS};
+
+
+class CardTags
+{
+public:
+    CardTags();
+    CardTags(const QJsonArray &jsonTags);
+
+//Variables
+private:
+    quint32 bits;
+
+//Metodos
+public:
+    bool contains(CardTag tag) const;
+    bool isEmpty() const;
+    static CardTag tagFromString(const QString &tagString);
+};
+
+
+//Datos de una carta preparados para las reglas de sinergias, se crean una vez al cargar cards.json
+class CardRuleData
+{
+public:
+    QString text;//enUS, lowercase, sin saltos de linea
+    CardTags mechanics;
+    CardTags referencedTags;
+};
+
+#endif // CARDTAGS_H
@@ -0,0 +1,111 @@
+#include "draftdeckstate.h"
+#include <algorithm>
+
+
+DraftDeckState::DraftDeckState()
+{
+    version = 0;
+    reset();
+}
+
+
+void DraftDeckState::reset()
+{
+    version++;
+    numCards = totalMana = 0;
+    draw = toYourHand = discover = 0;
+    std::fill(typeCounts, typeCounts + V_NUM_TYPES, 0);
+    std::fill(dropCounts, dropCounts + V_NUM_DROPS, 0);
+    std::fill(raceCounts, raceCounts + V_NUM_RACES, 0);
+    std::fill(mechanicCounts, mechanicCounts + V_NUM_MECHANICS, 0);
+}
+
+
+//num < 0 quita cartas del mazo
+void DraftDeckState::addCard(const CardCounterData &data, int num)
+{
+    version++;
+    numCards += num;
+    totalMana += num * data.mana;
+    draw += num * data.draw;
+    toYourHand += num * data.toYourHand;
+    discover += num * data.discover;
+
+    for(int i=0; i<V_NUM_TYPES; i++)        if(data.typeGen[static_cast<size_t>(i)])        typeCounts[i] += num;
+    for(int i=0; i<V_NUM_RACES; i++)        if(data.raceGen[static_cast<size_t>(i)])        raceCounts[i] += num;
+    for(int i=0; i<V_NUM_MECHANICS; i++)    if(data.mechanicGen[static_cast<size_t>(i)])    mechanicCounts[i] += num;
+    if(data.drop >= 0 && data.drop < V_NUM_DROPS)   dropCounts[data.drop] += num;
+}
+
+
+void DraftDeckState::removeCard(const CardCounterData &data, int num)
+{
+    addCard(data, -num);
+}
+
+
+quint32 DraftDeckState::getVersion() const
+{
+    return version;
+}
+
+
+int DraftDeckState::getNumCards() const
+{
+    return numCards;
+}
+
+
+int DraftDeckState::getTotalMana() const
+{
+    return totalMana;
+}
+
+
+int DraftDeckState::getDraw() const
+{
+    return draw;
+}
+
+
+int DraftDeckState::getToYourHand() const
+{
+    return toYourHand;
+}
+
+
+int DraftDeckState::getDiscover() const
+{
+    return discover;
+}
+
+
+int DraftDeckState::getTypeCount(VisibleType type) const
+{
+    return typeCounts[type];
+}
+
+
+int DraftDeckState::getDropCount(VisibleDrop drop) const
+{
+    return dropCounts[drop];
+}
+
+
+int DraftDeckState::getRaceCount(VisibleRace race) const
+{
+    return raceCounts[race];
+}
+
+
+int DraftDeckState::getMechanicCount(VisibleMechanics mechanic) const
+{
+    return mechanicCounts[mechanic];
+}
+
+
+//Minions + spells + weapons, los contadores visibles de tipo (SynergyHandler::draftedCardsCount)
+int DraftDeckState::getDraftedCardsCount() const
+{
+    return typeCounts[V_MINION] + typeCounts[V_SPELL] + typeCounts[V_WEAPON];
+}
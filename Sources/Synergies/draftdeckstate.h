@@ -0,0 +1,59 @@
+#ifndef DRAFTDECKSTATE_H
+#define DRAFTDECKSTATE_H
+
+#include "../utility.h"
+#include <bitset>
+
+
+//Rasgos Gen/Syn de una carta (isXXXGen/isXXXSyn) y su aportacion a los contadores del mazo.
+//Se calcula una vez por code (SynergyHandler::precompileCardData).
+class CardCounterData
+{
+public:
+    std::bitset<V_NUM_TYPES> typeGen, typeSyn;
+    std::bitset<V_NUM_RACES> raceGen, raceSyn;
+    std::bitset<V_NUM_MECHANICS> mechanicGen, mechanicSyn;
+    int drop = -1;          //V_DROP2/V_DROP3/V_DROP4 o -1
+    int mana = 0;           //getCorrectedCardMana
+    int draw = 0;
+    int toYourHand = 0;
+    int discover = 0;
+};
+
+
+//Sumas acumuladas del mazo en draft. Cada pick es una actualizacion O(1) de arrays fijos.
+class DraftDeckState
+{
+public:
+    DraftDeckState();
+
+//Variables
+private:
+    quint32 version;        //Cambia con cada modificacion del mazo
+    int numCards;
+    int totalMana;
+    int draw, toYourHand, discover;
+    int typeCounts[V_NUM_TYPES];
+    int dropCounts[V_NUM_DROPS];
+    int raceCounts[V_NUM_RACES];
+    int mechanicCounts[V_NUM_MECHANICS];
+
+//Metodos
+public:
+    void reset();
+    void addCard(const CardCounterData &data, int num=1);
+    void removeCard(const CardCounterData &data, int num=1);
+    quint32 getVersion() const;
+    int getNumCards() const;
+    int getTotalMana() const;
+    int getDraw() const;
+    int getToYourHand() const;
+    int getDiscover() const;
+    int getTypeCount(VisibleType type) const;
+    int getDropCount(VisibleDrop drop) const;
+    int getRaceCount(VisibleRace race) const;
+    int getMechanicCount(VisibleMechanics mechanic) const;
+    int getDraftedCardsCount() const;
+};
+
+#endif // DRAFTDECKSTATE_H
@@ -79,10 +79,10 @@ bool DraftDropCounter::isGreenTargetDrop()
 }
 
 
-void DraftDropCounter::increase(const QString &code)
+void DraftDropCounter::increase(const QString &code, int num)
 {
     bool beforeGreenTargetDrop = isGreenTargetDrop();
-    DraftItemCounter::increase(code);
+    DraftItemCounter::increase(code, num);
     bool afterGreenTargetDrop = isGreenTargetDrop();
     if(beforeGreenTargetDrop != afterGreenTargetDrop)   drawBorder(afterGreenTargetDrop);
 }
@@ -29,7 +29,7 @@ private:
 public:
     void reset();
     void setTheme(QPixmap pixmap, int iconWidth=32, bool inDraftMechanicsWindow=false);
-    void increase(const QString &code);
+    void increase(const QString &code, int num=1);
     void setNumCards(int numCards);
     void increaseNumCards();
     MechanicBorderColor getMechanicBorderColor();
@@ -82,7 +82,6 @@ void DraftItemCounter::reset()
     this->counter = 0;
     this->deckCardList.clear();
     this->codeMap.clear();
-    this->codeSynMap.clear();
 
     if(labelIcon != nullptr)
     {
@@ -143,10 +142,11 @@ void DraftItemCounter::increase(int numIncrease, int draftedCardsCount)
         labelCounter->setText(QString::number((counter*10/std::max(1,draftedCardsCount))/10.0));
     }
 }
-void DraftItemCounter::increase(const QString &code)
+void DraftItemCounter::increase(const QString &code, int num)
 {
-    if(codeMap.contains(code))  codeMap[code]++;
-    else                        codeMap[code] = 1;
+    if(num <= 0)    return;
+    if(codeMap.contains(code))  codeMap[code] += num;
+    else                        codeMap[code] = num;
 
     if(labelIcon != nullptr)
     {
@@ -155,7 +155,7 @@ void DraftItemCounter::increase(const QString &code)
         {
             if(deckCard.getCode() == code)
             {
-                deckCard.total++;
+                deckCard.total += num;
                 deckCard.remaining = deckCard.total;
                 duplicatedCard = true;
                 break;
@@ -164,26 +164,21 @@ void DraftItemCounter::increase(const QString &code)
 
         if(!duplicatedCard)
         {
-            deckCardList.append(DeckCard(code));
+            DeckCard deckCard(code);
+            deckCard.total = deckCard.remaining = num;
+            deckCardList.append(deckCard);
         }
 
-        this->counter++;
-        labelCounter->setText(QString::number(counter));
-        if(counter == 1)
+        if(counter == 0)
         {
             labelIcon->setDisabled(false);
         }
+        this->counter += num;
+        labelCounter->setText(QString::number(counter));
     }
 }
 
 
-void DraftItemCounter::increaseSyn(const QString &code)
-{
-    if(codeSynMap.contains(code))   codeSynMap[code]++;
-    else                            codeSynMap[code] = 1;
-}
-
-
 //Se usa para obtener las sinergias de los direct links
 bool DraftItemCounter::insertCode(const QString code, QMap<QString,int> &synergies)
 {
@@ -199,30 +194,6 @@ bool DraftItemCounter::insertCode(const QString code, QMap<QString,int> &synergi
 }
 
 
-void DraftItemCounter::insertCards(QMap<QString,int> &synergies)
-{
-    for(QString code: codeMap.keys())
-    {
-        if(!synergies.contains(code))
-        {
-            synergies[code] = codeMap[code];
-        }
-    }
-}
-
-
-void DraftItemCounter::insertSynCards(QMap<QString,int> &synergies)
-{
-    for(QString code: codeSynMap.keys())
-    {
-        if(!synergies.contains(code))
-        {
-            synergies[code] = codeSynMap[code];
-        }
-    }
-}
-
-
 int DraftItemCounter::count()
 {
     return counter;
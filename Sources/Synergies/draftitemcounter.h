@@ -21,7 +21,7 @@ private:
     QLabel *labelCounter;
     int counter;
     QList<DeckCard> deckCardList;
-    QMap<QString, int> codeMap, codeSynMap;
+    QMap<QString, int> codeMap;
 
 protected:
     HoverLabel *labelIcon;
@@ -35,11 +35,8 @@ public:
     void reset();
     void setTransparency(Transparency transparency, bool mouseInApp);
     void increase(int numIncrease, int draftedCardsCount);
-    void increase(const QString &code);
+    void increase(const QString &code, int num=1);
     bool insertCode(const QString code, QMap<QString, int> &synergies);
-    void insertCards(QMap<QString, int> &synergies);
-    void increaseSyn(const QString &code);
-    void insertSynCards(QMap<QString, int> &synergies);
     int count();
     QMap<QString, int> &getCodeMap();
     void setTheme(QPixmap pixmap, int iconWidth=32, bool inDraftMechanicsWindow=false);
@@ -0,0 +1,143 @@
+#include "draftlookahead.h"
+#include "draftdropcounter.h"
+#include <algorithm>
+#include <random>
+#include <cmath>
+
+//Mecanicas visibles en el mazo y cuantas cartas de cada una consideramos suficientes en 30 cartas
+static const VisibleMechanics lookaheadMechanics[LOOKAHEAD_NUM_MECHANICS] =
+    {V_AOE, V_TAUNT_ALL, V_SURVIVABILITY, V_DISCOVER_DRAW, V_PING, V_DAMAGE, V_DESTROY, V_REACH};
+static const int lookaheadMechanicTargets[LOOKAHEAD_NUM_MECHANICS] =
+    {2, 3, 2, 3, 2, 4, 2, 2};
+
+
+LookaheadCard DraftLookahead::makeCard(const CardCounterData &data, float score, float pickrate)
+{
+    LookaheadCard card;
+    card.score = score;
+    card.pickrate = pickrate;
+    card.mana = data.mana;
+    card.drop = data.drop;
+    for(int i=0; i<LOOKAHEAD_NUM_MECHANICS; i++)
+    {
+        if(data.mechanicGen[lookaheadMechanics[i]])  card.mechanics |= (1 << i);
+    }
+    return card;
+}
+
+
+LookaheadDeck DraftLookahead::makeDeck(const DraftDeckState &deckState, float scoreSum, float scoreScale)
+{
+    LookaheadDeck deck;
+    deck.numCards = deckState.getNumCards();
+    deck.totalMana = deckState.getTotalMana();
+    deck.scoreSum = scoreSum;
+    deck.scoreScale = scoreScale;
+    for(int i=0; i<V_NUM_DROPS; i++)
+    {
+        deck.drops[i] = deckState.getDropCount(static_cast<VisibleDrop>(i));
+    }
+    for(int i=0; i<LOOKAHEAD_NUM_MECHANICS; i++)
+    {
+        deck.mechanics[i] = deckState.getMechanicCount(lookaheadMechanics[i]);
+    }
+    return deck;
+}
+
+
+//Desviacion tipica de los scores del pool: LightForge/HearthArena (0-100+) y HSReplay (winrates ~50) tienen escalas distintas
+float DraftLookahead::getScoreScale(const QVector<LookaheadCard> &pool)
+{
+    if(pool.count() < 2)    return 1;
+
+    double sum = 0, sumSq = 0;
+    for(const LookaheadCard &card: pool)
+    {
+        sum += static_cast<double>(card.score);
+        sumSq += static_cast<double>(card.score) * static_cast<double>(card.score);
+    }
+    const double mean = sum/pool.count();
+    const double variance = sumSq/pool.count() - mean*mean;
+    if(variance <= 0)   return 1;
+    return static_cast<float>(std::sqrt(variance));
+}
+
+
+void LookaheadDeck::addCard(const LookaheadCard &card)
+{
+    numCards++;
+    totalMana += card.mana;
+    scoreSum += card.score;
+    if(card.drop >= 0 && card.drop < V_NUM_DROPS)   drops[card.drop]++;
+    for(int i=0; i<LOOKAHEAD_NUM_MECHANICS; i++)
+    {
+        if(card.mechanics & (1 << i))   mechanics[i]++;
+    }
+}
+
+
+//Score medio, penalizado por drops por debajo del objetivo (escalado al tamano del mazo) y curva alta,
+//bonificado por cada carta de mecanica hasta su objetivo
+float LookaheadDeck::value() const
+{
+    if(numCards == 0)   return 0;
+
+    float value = scoreSum/numCards;
+
+    const int dropTargets[V_NUM_DROPS] = {TARGET_DROP_2, TARGET_DROP_3, TARGET_DROP_4};
+    for(int i=0; i<V_NUM_DROPS; i++)
+    {
+        int missingDrops = dropTargets[i] * numCards / LOOKAHEAD_DECK_SIZE - drops[i];
+        if(missingDrops > 0)    value -= LOOKAHEAD_DROP_PENALTY * scoreScale * missingDrops;
+    }
+
+    for(int i=0; i<LOOKAHEAD_NUM_MECHANICS; i++)
+    {
+        int mechanicTarget = std::max(1, lookaheadMechanicTargets[i] * numCards / LOOKAHEAD_DECK_SIZE);
+        value += LOOKAHEAD_MECHANIC_BONUS * scoreScale * std::min(mechanics[i], mechanicTarget);
+    }
+
+    float avgMana = totalMana/static_cast<float>(numCards);
+    if(avgMana > LOOKAHEAD_MAX_AVG_MANA)    value -= LOOKAHEAD_MANA_PENALTY * scoreScale * (avgMana - LOOKAHEAD_MAX_AVG_MANA);
+
+    return value;
+}
+
+
+//Valor esperado del mazo final si elegimos task.candidate. En cada pick restante se ofrecen 3 cartas
+//aleatorias del pool y se elige la de mayor pickrate en HSReplay (score si no hay pickrates).
+//Todos los candidatos usan la misma semilla: se comparan sobre las mismas ofertas.
+float DraftLookahead::evaluate(const LookaheadTask &task)
+{
+    LookaheadDeck baseDeck = task.deck;
+    baseDeck.addCard(task.candidate);
+
+    const int remainingPicks = LOOKAHEAD_DECK_SIZE - baseDeck.numCards;
+    if(task.pool.isNull() || task.pool->isEmpty() || remainingPicks <= 0)  return baseDeck.value();
+
+    const QVector<LookaheadCard> &pool = *task.pool;
+    std::mt19937 generator(task.seed);
+    std::uniform_int_distribution<int> randomCard(0, pool.count() - 1);
+
+    float totalValue = 0;
+    for(int sim=0; sim<LOOKAHEAD_SIMULATIONS; sim++)
+    {
+        LookaheadDeck deck = baseDeck;
+        for(int pick=0; pick<remainingPicks; pick++)
+        {
+            const LookaheadCard *bestCard = nullptr;
+            for(int i=0; i<3; i++)
+            {
+                const LookaheadCard &card = pool[randomCard(generator)];
+                if(bestCard == nullptr || card.pickrate > bestCard->pickrate ||
+                        (FLOATEQ(card.pickrate, bestCard->pickrate) && card.score > bestCard->score))
+                {
+                    bestCard = &card;
+                }
+            }
+            deck.addCard(*bestCard);
+        }
+        totalValue += deck.value();
+    }
+    return totalValue/LOOKAHEAD_SIMULATIONS;
+}
@@ -0,0 +1,66 @@
+#ifndef DRAFTLOOKAHEAD_H
+#define DRAFTLOOKAHEAD_H
+
+#include "draftdeckstate.h"
+#include <QVector>
+#include <QSharedPointer>
+
+#define LOOKAHEAD_SIMULATIONS       256
+#define LOOKAHEAD_DECK_SIZE         30
+#define LOOKAHEAD_NUM_MECHANICS     8
+//Penalizaciones/bonus en desviaciones tipicas del score del pool (LookaheadDeck::scoreScale),
+//asi pesan lo mismo con LightForge, HearthArena o HSReplay
+#define LOOKAHEAD_DROP_PENALTY      0.2f
+#define LOOKAHEAD_MECHANIC_BONUS    0.15f
+#define LOOKAHEAD_MANA_PENALTY      0.35f
+#define LOOKAHEAD_MAX_AVG_MANA      4.0f
+
+
+//Carta reducida a lo que usa la simulacion
+class LookaheadCard
+{
+public:
+    float score = 0;
+    float pickrate = 0;
+    int mana = 0;
+    int drop = -1;
+    quint8 mechanics = 0;   //Bit i --> lookaheadMechanics[i]
+};
+
+
+class LookaheadDeck
+{
+public:
+    int numCards = 0;
+    int totalMana = 0;
+    float scoreSum = 0;
+    float scoreScale = 1;
+    int drops[V_NUM_DROPS] = {};
+    int mechanics[LOOKAHEAD_NUM_MECHANICS] = {};
+
+    void addCard(const LookaheadCard &card);
+    float value() const;
+};
+
+
+//Una simulacion por candidato; se evaluan en paralelo con QtConcurrent::mapped
+class LookaheadTask
+{
+public:
+    LookaheadDeck deck;
+    LookaheadCard candidate;
+    QSharedPointer<const QVector<LookaheadCard>> pool;
+    quint32 seed = 0;
+};
+
+
+class DraftLookahead
+{
+public:
+    static LookaheadCard makeCard(const CardCounterData &data, float score, float pickrate);
+    static LookaheadDeck makeDeck(const DraftDeckState &deckState, float scoreSum, float scoreScale);
+    static float getScoreScale(const QVector<LookaheadCard> &pool);
+    static float evaluate(const LookaheadTask &task);
+};
+
+#endif // DRAFTLOOKAHEAD_H
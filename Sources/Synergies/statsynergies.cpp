@@ -123,12 +123,12 @@ void StatSynergies::qDebugContents()
 }
 
 
-QList<StatSyn> StatSynergies::getStatsSynergiesFromJson(const QString &code, QMap<QString, QList<QString>> &synergyCodes)
+//Se llama una vez por carta al cargar synergies.json (CardSynergyRules)
+QList<StatSyn> StatSynergies::getStatsSynergiesFromJson(const QString &code, const QStringList &jsonKeys)
 {
     QList<StatSyn> statSyns;
 
-    if(!synergyCodes.contains(code))    return statSyns;
-    for(QString mechanic: synergyCodes[code])
+    for(QString mechanic: jsonKeys)
     {
         if(mechanic[0] == '=')
         {
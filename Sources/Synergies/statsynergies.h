@@ -32,7 +32,7 @@ private:
 
 //Metodos
 public:
-    static QList<StatSyn> getStatsSynergiesFromJson(const QString &code, QMap<QString, QList<QString> > &synergyCodes);
+    static QList<StatSyn> getStatsSynergiesFromJson(const QString &code, const QStringList &jsonKeys);
     void clear();
     void qDebugContents();
     void updateStatsMapSyn(const StatSyn &statSyn, QString &code);
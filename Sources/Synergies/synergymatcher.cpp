@@ -0,0 +1,152 @@
+#include "synergymatcher.h"
+
+
+SynergyMatcher::SynergyMatcher()
+{
+    reset();
+}
+
+
+//Mismas reglas que usaba getSynergies con los DraftItemCounter:
+//-Solo icono: discoverDraw, damage, destroy, reach y survivability no buscan sinergias.
+//-Gen-gen: jadeGolem y heroPower buscan cartas del mazo con el mismo gen.
+//-Spell/minion gen no buscan sinergias (evita mostrar spellSyn cards en cada hechizo).
+//-tokenCardGen no cuenta en el mazo y returnSyn es synergia debil como candidata.
+SynergyFeatures SynergyMatcher::getFeatures(const CardCounterData &data)
+{
+    SynergyFeatures features;
+
+    for(int i=0; i<V_NUM_TYPES; i++)
+    {
+        const size_t bit = static_cast<size_t>(i);
+        if(data.typeGen[bit])
+        {
+            features.gen.set(bit);
+            if(i == V_WEAPON || i == V_WEAPON_ALL)  features.lookSyn.set(bit);
+        }
+        if(data.typeSyn[bit])
+        {
+            features.syn.set(bit);
+            features.lookGen.set(bit);
+        }
+    }
+
+    for(int i=0; i<V_NUM_RACES; i++)
+    {
+        const size_t bit = static_cast<size_t>(V_NUM_TYPES + i);
+        if(data.raceGen[static_cast<size_t>(i)])
+        {
+            features.gen.set(bit);
+            features.lookSyn.set(bit);
+        }
+        if(data.raceSyn[static_cast<size_t>(i)])
+        {
+            features.syn.set(bit);
+            features.lookGen.set(bit);
+        }
+    }
+
+    for(int i=0; i<V_NUM_MECHANICS; i++)
+    {
+        const size_t bit = static_cast<size_t>(V_NUM_TYPES + V_NUM_RACES + i);
+        if(data.mechanicGen[static_cast<size_t>(i)])
+        {
+            if(i != V_TOKEN_CARD)   features.gen.set(bit);
+
+            switch(i)
+            {
+                case V_DISCOVER_DRAW:
+                case V_DAMAGE:
+                case V_DESTROY:
+                case V_REACH:
+                case V_SURVIVABILITY:
+                    break;
+                case V_JADE_GOLEM:
+                case V_HERO_POWER:
+                    features.lookGen.set(bit);
+                    break;
+                default:
+                    features.lookSyn.set(bit);
+                    break;
+            }
+        }
+        if(data.mechanicSyn[static_cast<size_t>(i)])
+        {
+            features.syn.set(bit);
+            if(i != V_RETURN)   features.lookGen.set(bit);
+        }
+    }
+
+    return features;
+}
+
+
+void SynergyMatcher::reset()
+{
+    entries.clear();
+    entryIndex.clear();
+    deckGen.reset();
+    deckSyn.reset();
+}
+
+
+//num < 0 quita cartas del mazo
+void SynergyMatcher::addCard(const QString &code, const CardCounterData &data, int num)
+{
+    QHash<QString, int>::const_iterator it = entryIndex.constFind(code);
+    if(it == entryIndex.constEnd())
+    {
+        if(num <= 0)    return;
+
+        DeckEntry entry;
+        entry.code = code;
+        entry.features = getFeatures(data);
+        entry.total = num;
+        entryIndex[code] = entries.count();
+        entries.append(entry);
+        deckGen |= entry.features.gen;
+        deckSyn |= entry.features.syn;
+        return;
+    }
+
+    DeckEntry &entry = entries[it.value()];
+    entry.total += num;
+    if(entry.total > 0)     return;
+
+    //Carta eliminada del mazo: reconstruimos indices y ORs
+    entries.remove(it.value());
+    entryIndex.clear();
+    for(int i=0; i<entries.count(); i++)    entryIndex[entries[i].code] = i;
+    updateDeckBits();
+}
+
+
+void SynergyMatcher::updateDeckBits()
+{
+    deckGen.reset();
+    deckSyn.reset();
+    for(const DeckEntry &entry: entries)
+    {
+        deckGen |= entry.features.gen;
+        deckSyn |= entry.features.syn;
+    }
+}
+
+
+bool SynergyMatcher::hasSynergies(const SynergyFeatures &candidate) const
+{
+    return (candidate.lookSyn & deckSyn).any() || (candidate.lookGen & deckGen).any();
+}
+
+
+//Cartas del mazo con sinergia con la candidata --> copias en el mazo
+void SynergyMatcher::insertSynergies(const SynergyFeatures &candidate, QMap<QString, int> &synergies) const
+{
+    if(!hasSynergies(candidate))    return;
+
+    for(const DeckEntry &entry: entries)
+    {
+        if((candidate.lookSyn & entry.features.syn).none() && (candidate.lookGen & entry.features.gen).none())  continue;
+        if(!synergies.contains(entry.code))     synergies[entry.code] = entry.total;
+    }
+}
@@ -0,0 +1,61 @@
+#ifndef SYNERGYMATCHER_H
+#define SYNERGYMATCHER_H
+
+#include "draftdeckstate.h"
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <bitset>
+
+#define SYNERGY_NUM_BITS    (V_NUM_TYPES + V_NUM_RACES + V_NUM_MECHANICS)
+
+typedef std::bitset<SYNERGY_NUM_BITS> SynergyBits;
+
+
+//Rasgos de una carta para el match: tipos, razas y mecanicas en un unico bitset
+class SynergyFeatures
+{
+public:
+    SynergyBits gen;        //Gen que cuentan en el mazo (mismos que los counters)
+    SynergyBits syn;        //Syn que cuentan en el mazo
+    SynergyBits lookSyn;    //Como candidata: busca cartas del mazo con estos syn
+    SynergyBits lookGen;    //Como candidata: busca cartas del mazo con estos gen
+};
+
+
+//Mazo en draft como indices de carta + copias.
+//El match candidata-mazo son AND de bitsets; los DraftItemCounter quedan como vistas para la UI.
+class SynergyMatcher
+{
+public:
+    SynergyMatcher();
+
+private:
+    class DeckEntry
+    {
+    public:
+        QString code;
+        SynergyFeatures features;
+        int total = 0;
+    };
+
+//Variables
+private:
+    QVector<DeckEntry> entries;
+    QHash<QString, int> entryIndex;
+    SynergyBits deckGen, deckSyn;   //OR de todo el mazo, descarta candidatas sin sinergias
+
+//Metodos
+private:
+    void updateDeckBits();
+
+public:
+    static SynergyFeatures getFeatures(const CardCounterData &data);
+    void reset();
+    void addCard(const QString &code, const CardCounterData &data, int num=1);
+    bool hasSynergies(const SynergyFeatures &candidate) const;
+    void insertSynergies(const SynergyFeatures &candidate, QMap<QString, int> &synergies) const;
+};
+
+#endif // SYNERGYMATCHER_H
@@ -0,0 +1,97 @@
+#include "synergyrules.h"
+#include <QHash>
+
+
+CardSynergyRules::CardSynergyRules()
+{
+    discover = draw = toYourHand = -1;
+}
+
+
+CardSynergyRules::CardSynergyRules(const QString &code, const QStringList &jsonKeys)
+{
+    this->jsonKeys = jsonKeys;
+    for(const QString &keyString: jsonKeys)
+    {
+        SynergyKey key = keyFromString(keyString);
+        if(key != SK_NUM_KEYS)  keys.set(key);
+    }
+    statSyns = StatSynergies::getStatsSynergiesFromJson(code, jsonKeys);
+    discover = getKeyNumber(jsonKeys, "discover");
+    draw = getKeyNumber(jsonKeys, "drawGen");
+    toYourHand = getKeyNumber(jsonKeys, "toYourHandGen");
+}
+
+
+//La primera clave que empieza por prefix decide: prefix --> 1, prefixN --> N
+int CardSynergyRules::getKeyNumber(const QStringList &jsonKeys, const QString &prefix)
+{
+    for(const QString &keyString: jsonKeys)
+    {
+        if(keyString.startsWith(prefix))
+        {
+            if(keyString.length() == prefix.length())   return 1;
+            return keyString.mid(prefix.length()).toInt();
+        }
+    }
+    return -1;
+}
+
+
+bool CardSynergyRules::contains(SynergyKey key) const
+{
+    return keys[static_cast<size_t>(key)];
+}
+
+
+SynergyKey CardSynergyRules::keyFromString(const QString &keyString)
+{
+    static const char *keyStrings[SK_NUM_KEYS] = {
+        "spellGen", "weaponGen", "murlocGen", "demonGen", "mechGen", "elementalGen", "beastGen", "totemGen", "pirateGen", "dragonGen",
+        "spellSyn", "weaponSyn", "murlocSyn", "demonSyn", "mechSyn", "elementalSyn", "beastSyn", "totemSyn", "pirateSyn", "dragonSyn",
+        "spellAllSyn", "weaponAllSyn", "murlocAllSyn", "demonAllSyn", "mechAllSyn", "elementalAllSyn", "beastAllSyn", "totemAllSyn", "pirateAllSyn", "dragonAllSyn",
+
+        "drop2", "drop3", "drop4",
+
+        "discover", "drawGen", "toYourHandGen", "enemyDrawGen",
+        "discoverSyn", "drawSyn", "toYourHandSyn", "enemyDrawSyn",
+
+        "taunt", "tauntGen", "divineShield", "divineShieldGen", "windfury", "overload",
+        "tauntSyn", "tauntAllSyn", "divineShieldSyn", "divineShieldAllSyn", "windfuryMinionSyn", "overloadSyn",
+
+        "jadeGolemGen", "secret", "secretGen", "freezeEnemyGen", "discardGen", "stealthGen",
+        "heroPowerGen", "secretSyn", "secretAllSyn", "freezeEnemySyn", "discardSyn", "stealthSyn",
+
+        "damageMinionsGen", "reachGen", "pingGen", "aoeGen", "destroyGen",
+        "damageMinionsSyn", "reachSyn", "pingSyn", "aoeSyn", "destroySyn",
+
+        "deathrattle", "deathrattleGen", "deathrattleOpponent", "silenceOwnGen", "battlecry", "battlecryGen", "returnGen",
+        "deathrattleSyn", "deathrattleGoodAllSyn", "silenceOwnSyn", "battlecrySyn", "battlecryAllSyn", "returnSyn",
+
+        "enrageGen", "tauntGiverGen", "evolveGen", "spawnEnemyGen", "spellDamageGen", "handBuffGen", "spellBuffGen",
+        "enrageSyn", "tauntGiverSyn", "evolveSyn", "spawnEnemySyn", "spellDamageSyn", "handBuffSyn", "spellBuffSyn",
+
+        "tokenGen", "tokenCardGen", "comboGen", "attackBuffGen", "healthBuffGen", "heroAttackGen",
+        "tokenSyn", "tokenCardSyn", "comboSyn", "attackBuffSyn", "healthBuffSyn", "heroAttackSyn",
+
+        "restoreTargetMinionGen", "restoreFriendlyHeroGen", "restoreFriendlyMinionGen",
+        "restoreTargetMinionSyn", "restoreFriendlyHeroSyn", "restoreFriendlyMinionSyn",
+
+        "armorGen", "lifesteal", "lifestealGen",
+        "armorSyn", "lifestealMinionSyn", "lifestealAllSyn",
+
+        "eggGen", "damageFriendlyHeroGen", "echo", "echoGen", "rush", "rushGen", "magnetic", "magneticGen",
+        "eggSyn", "damageFriendlyHeroSyn", "echoSyn", "echoAllSyn", "rushSyn", "rushAllSyn", "magneticSyn", "magneticAllSyn",
+
+        "otherClassGen", "silverHandGen", "treantGen", "lackeyGen",
+        "otherClassSyn", "silverHandSyn", "treantSyn", "lackeySyn"
+        //New Synergy Step 7
+    };
+
+    static QHash<QString, SynergyKey> keyMap;
+    if(keyMap.isEmpty())
+    {
+        for(int i=0; i<SK_NUM_KEYS; i++)    keyMap[QLatin1String(keyStrings[i])] = static_cast<SynergyKey>(i);
+    }
+    return keyMap.value(keyString, SK_NUM_KEYS);
+}
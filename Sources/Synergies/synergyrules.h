@@ -0,0 +1,66 @@
+#ifndef SYNERGYRULES_H
+#define SYNERGYRULES_H
+
+#include "statsynergies.h"
+#include <QString>
+#include <QStringList>
+#include <bitset>
+
+
+//Claves de synergies.json, en el mismo orden que keyStrings (synergyrules.cpp)
+enum SynergyKey {SK_SPELL_GEN, SK_WEAPON_GEN, SK_MURLOC_GEN, SK_DEMON_GEN, SK_MECH_GEN, SK_ELEMENTAL_GEN, SK_BEAST_GEN, SK_TOTEM_GEN, SK_PIRATE_GEN, SK_DRAGON_GEN,
+                 SK_SPELL_SYN, SK_WEAPON_SYN, SK_MURLOC_SYN, SK_DEMON_SYN, SK_MECH_SYN, SK_ELEMENTAL_SYN, SK_BEAST_SYN, SK_TOTEM_SYN, SK_PIRATE_SYN, SK_DRAGON_SYN,
+                 SK_SPELL_ALL_SYN, SK_WEAPON_ALL_SYN, SK_MURLOC_ALL_SYN, SK_DEMON_ALL_SYN, SK_MECH_ALL_SYN, SK_ELEMENTAL_ALL_SYN, SK_BEAST_ALL_SYN, SK_TOTEM_ALL_SYN, SK_PIRATE_ALL_SYN, SK_DRAGON_ALL_SYN,
+                 SK_DROP2, SK_DROP3, SK_DROP4,
+                 SK_DISCOVER, SK_DRAW_GEN, SK_TO_YOUR_HAND_GEN, SK_ENEMY_DRAW_GEN,
+                 SK_DISCOVER_SYN, SK_DRAW_SYN, SK_TO_YOUR_HAND_SYN, SK_ENEMY_DRAW_SYN,
+                 SK_TAUNT, SK_TAUNT_GEN, SK_DIVINE_SHIELD, SK_DIVINE_SHIELD_GEN, SK_WINDFURY, SK_OVERLOAD,
+                 SK_TAUNT_SYN, SK_TAUNT_ALL_SYN, SK_DIVINE_SHIELD_SYN, SK_DIVINE_SHIELD_ALL_SYN, SK_WINDFURY_MINION_SYN, SK_OVERLOAD_SYN,
+                 SK_JADE_GOLEM_GEN, SK_SECRET, SK_SECRET_GEN, SK_FREEZE_ENEMY_GEN, SK_DISCARD_GEN, SK_STEALTH_GEN,
+                 SK_HERO_POWER_GEN, SK_SECRET_SYN, SK_SECRET_ALL_SYN, SK_FREEZE_ENEMY_SYN, SK_DISCARD_SYN, SK_STEALTH_SYN,
+                 SK_DAMAGE_MINIONS_GEN, SK_REACH_GEN, SK_PING_GEN, SK_AOE_GEN, SK_DESTROY_GEN,
+                 SK_DAMAGE_MINIONS_SYN, SK_REACH_SYN, SK_PING_SYN, SK_AOE_SYN, SK_DESTROY_SYN,
+                 SK_DEATHRATTLE, SK_DEATHRATTLE_GEN, SK_DEATHRATTLE_OPPONENT, SK_SILENCE_OWN_GEN, SK_BATTLECRY, SK_BATTLECRY_GEN, SK_RETURN_GEN,
+                 SK_DEATHRATTLE_SYN, SK_DEATHRATTLE_GOOD_ALL_SYN, SK_SILENCE_OWN_SYN, SK_BATTLECRY_SYN, SK_BATTLECRY_ALL_SYN, SK_RETURN_SYN,
+                 SK_ENRAGE_GEN, SK_TAUNT_GIVER_GEN, SK_EVOLVE_GEN, SK_SPAWN_ENEMY_GEN, SK_SPELL_DAMAGE_GEN, SK_HAND_BUFF_GEN, SK_SPELL_BUFF_GEN,
+                 SK_ENRAGE_SYN, SK_TAUNT_GIVER_SYN, SK_EVOLVE_SYN, SK_SPAWN_ENEMY_SYN, SK_SPELL_DAMAGE_SYN, SK_HAND_BUFF_SYN, SK_SPELL_BUFF_SYN,
+                 SK_TOKEN_GEN, SK_TOKEN_CARD_GEN, SK_COMBO_GEN, SK_ATTACK_BUFF_GEN, SK_HEALTH_BUFF_GEN, SK_HERO_ATTACK_GEN,
+                 SK_TOKEN_SYN, SK_TOKEN_CARD_SYN, SK_COMBO_SYN, SK_ATTACK_BUFF_SYN, SK_HEALTH_BUFF_SYN, SK_HERO_ATTACK_SYN,
+                 SK_RESTORE_TARGET_MINION_GEN, SK_RESTORE_FRIENDLY_HERO_GEN, SK_RESTORE_FRIENDLY_MINION_GEN,
+                 SK_RESTORE_TARGET_MINION_SYN, SK_RESTORE_FRIENDLY_HERO_SYN, SK_RESTORE_FRIENDLY_MINION_SYN,
+                 SK_ARMOR_GEN, SK_LIFESTEAL, SK_LIFESTEAL_GEN,
+                 SK_ARMOR_SYN, SK_LIFESTEAL_MINION_SYN, SK_LIFESTEAL_ALL_SYN,
+                 SK_EGG_GEN, SK_DAMAGE_FRIENDLY_HERO_GEN, SK_ECHO, SK_ECHO_GEN, SK_RUSH, SK_RUSH_GEN, SK_MAGNETIC, SK_MAGNETIC_GEN,
+                 SK_EGG_SYN, SK_DAMAGE_FRIENDLY_HERO_SYN, SK_ECHO_SYN, SK_ECHO_ALL_SYN, SK_RUSH_SYN, SK_RUSH_ALL_SYN, SK_MAGNETIC_SYN, SK_MAGNETIC_ALL_SYN,
+                 SK_OTHER_CLASS_GEN, SK_SILVER_HAND_GEN, SK_TREANT_GEN, SK_LACKEY_GEN,
+                 SK_OTHER_CLASS_SYN, SK_SILVER_HAND_SYN, SK_TREANT_SYN, SK_LACKEY_SYN,
+                 SK_NUM_KEYS};
+//New Synergy Step 7
+
+
+//Reglas de una carta de synergies.json, se compilan una vez al cargar el fichero (initSynergyCodes)
+class CardSynergyRules
+{
+public:
+    CardSynergyRules();
+    CardSynergyRules(const QString &code, const QStringList &jsonKeys);
+
+//Variables
+public:
+    QStringList jsonKeys;       //Claves originales, solo para debug
+    std::bitset<SK_NUM_KEYS> keys;
+    QList<StatSyn> statSyns;    //Claves "=..." ya parseadas
+    int discover;               //discoverN, drawGenN, toYourHandGenN (sin N: 1). -1 si no aparece.
+    int draw;
+    int toYourHand;
+
+//Metodos
+private:
+    static int getKeyNumber(const QStringList &jsonKeys, const QString &prefix);
+
+public:
+    bool contains(SynergyKey key) const;
+    static SynergyKey keyFromString(const QString &keyString);
+};
+
+#endif // SYNERGYRULES_H
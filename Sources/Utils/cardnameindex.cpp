@@ -0,0 +1,244 @@
+#include "cardnameindex.h"
+#include <QSet>
+#include <QElapsedTimer>
+#include <QtWidgets>
+#include <algorithm>
+
+
+CardNameIndex::CardNameIndex()
+{
+
+}
+
+
+//Quita acentos (NFKD + marcas), ligaduras y mayusculas. "Ragnaros, Señor del Fuego" --> "ragnaros, senor del fuego"
+QString CardNameIndex::foldName(const QString &name)
+{
+    QString decomposed = name.normalized(QString::NormalizationForm_KD);
+    QString folded;
+    folded.reserve(decomposed.length());
+
+    for(const QChar &c: decomposed)
+    {
+        if(c.category() == QChar::Mark_NonSpacing)              continue;
+        else if(c == QChar(0x00DF))                             folded.append("ss");
+        else if(c == QChar(0x0152) || c == QChar(0x0153))       folded.append("oe");
+        else if(c == QChar(0x00C6) || c == QChar(0x00E6))       folded.append("ae");
+        else if(c == QChar(0x00D8) || c == QChar(0x00F8))       folded.append('o');
+        else if(c == QChar(0x0141) || c == QChar(0x0142))       folded.append('l');
+        else if(c == QChar(0x00D0) || c == QChar(0x00F0))       folded.append('d');
+        else if(c == QChar(0x0131))                             folded.append('i');
+        else                                                    folded.append(c);
+    }
+
+    return folded.toCaseFolded().simplified();
+}
+
+
+//Trigramas unicos con padding "  name " para que los nombres cortos (CJK) tambien tengan trigramas
+QVector<quint64> CardNameIndex::getTrigrams(const QString &foldedName)
+{
+    QString padded = "  " + foldedName + " ";
+    QVector<quint64> trigrams;
+    trigrams.reserve(padded.length());
+
+    for(int i=0; i+2<padded.length(); i++)
+    {
+        quint64 trigram = (static_cast<quint64>(padded[i].unicode()) << 32) |
+                          (static_cast<quint64>(padded[i+1].unicode()) << 16) |
+                          static_cast<quint64>(padded[i+2].unicode());
+        if(!trigrams.contains(trigram))     trigrams.append(trigram);
+    }
+    return trigrams;
+}
+
+
+void CardNameIndex::clear()
+{
+    entries.clear();
+    exactMap.clear();
+    sortedEntries.clear();
+    trigramMap.clear();
+}
+
+
+bool CardNameIndex::isEmpty() const
+{
+    return entries.isEmpty();
+}
+
+
+void CardNameIndex::build(const QMap<QString, QJsonObject> &cardsJson)
+{
+    clear();
+
+    for(QMap<QString, QJsonObject>::const_iterator it = cardsJson.cbegin(); it != cardsJson.cend(); it++)
+    {
+        const QString &code = it.key();
+        QJsonObject namesObject = it->value("name").toObject();
+        bool playable = !it->value("cost").isUndefined();
+
+        //Muchos idiomas comparten nombre, solo indexamos una vez cada nombre plegado
+        QSet<QString> cardFoldedNames;
+        for(const QString &lang: namesObject.keys())
+        {
+            QString foldedName = foldName(namesObject.value(lang).toString());
+            if(foldedName.isEmpty() || cardFoldedNames.contains(foldedName))  continue;
+            cardFoldedNames.insert(foldedName);
+
+            NameEntry entry;
+            entry.foldedName = foldedName;
+            entry.code = code;
+            entry.numTrigrams = 0;
+
+            int id = entries.count();
+            exactMap[foldedName].append(id);
+
+            if(playable)
+            {
+                QVector<quint64> trigrams = getTrigrams(foldedName);
+                entry.numTrigrams = trigrams.count();
+                for(const quint64 &trigram: trigrams)   trigramMap[trigram].append(id);
+                sortedEntries.append(id);
+            }
+            entries.append(entry);
+        }
+    }
+
+    std::sort(sortedEntries.begin(), sortedEntries.end(), [this](int a, int b)
+    {
+        return entries[a].foldedName < entries[b].foldedName;
+    });
+}
+
+
+void CardNameIndex::appendUnique(QStringList &codes, const QString &code, int maxResults)
+{
+    if(codes.count() < maxResults && !codes.contains(code))  codes.append(code);
+}
+
+
+//Codes cuyo nombre (en cualquier idioma) coincide sin tener en cuenta acentos ni mayusculas, en orden de code
+QStringList CardNameIndex::exactCodes(const QString &name) const
+{
+    QStringList codes;
+    for(int id: exactMap.value(foldName(name)))
+    {
+        appendUnique(codes, entries[id].code, entries.count());
+    }
+    return codes;
+}
+
+
+QStringList CardNameIndex::prefixCodes(const QString &prefix, int maxResults) const
+{
+    QStringList codes;
+    QString foldedPrefix = foldName(prefix);
+    if(foldedPrefix.isEmpty())  return codes;
+
+    QVector<int>::const_iterator it = std::lower_bound(sortedEntries.cbegin(), sortedEntries.cend(), foldedPrefix,
+        [this](int id, const QString &value)
+        {
+            return entries[id].foldedName < value;
+        });
+
+    for(; it != sortedEntries.cend() && codes.count() < maxResults; it++)
+    {
+        if(!entries[*it].foldedName.startsWith(foldedPrefix))   break;
+        appendUnique(codes, entries[*it].code, maxResults);
+    }
+    return codes;
+}
+
+
+//Similitud de Dice sobre trigramas: 2*comunes/(trigramasNombre + trigramasEntrada)
+QStringList CardNameIndex::fuzzyCodes(const QString &name, int maxResults, double minScore) const
+{
+    QStringList codes;
+    QVector<quint64> trigrams = getTrigrams(foldName(name));
+    if(trigrams.isEmpty())  return codes;
+
+    QHash<int, int> hits;
+    for(const quint64 &trigram: trigrams)
+    {
+        QHash<quint64, QVector<int>>::const_iterator postings = trigramMap.constFind(trigram);
+        if(postings == trigramMap.constEnd())   continue;
+        for(int id: postings.value())   hits[id]++;
+    }
+
+    QMap<QString, double> codeScores;
+    for(QHash<int, int>::const_iterator it = hits.constBegin(); it != hits.constEnd(); it++)
+    {
+        const NameEntry &entry = entries[it.key()];
+        double score = 2.0 * it.value() / (trigrams.count() + entry.numTrigrams);
+        if(score >= minScore && score > codeScores.value(entry.code, 0))
+        {
+            codeScores[entry.code] = score;
+        }
+    }
+
+    QList<QPair<double, QString>> ranking;
+    for(QMap<QString, double>::const_iterator it = codeScores.constBegin(); it != codeScores.constEnd(); it++)
+    {
+        ranking.append(qMakePair(-it.value(), it.key()));
+    }
+    std::sort(ranking.begin(), ranking.end());
+
+    for(const QPair<double, QString> &pair: ranking)
+    {
+        if(codes.count() >= maxResults) break;
+        codes.append(pair.second);
+    }
+    return codes;
+}
+
+
+//Peores casos: nombre mas largo, prefijo de 1 letra, nombre mal escrito y palabra muy comun
+void CardNameIndex::benchmark(const QMap<QString, QJsonObject> &cardsJson)
+{
+    QElapsedTimer timer;
+    timer.start();
+    build(cardsJson);
+    qDebug()<<"DEBUG NAME INDEX: Build:"<<timer.elapsed()<<"ms -"<<entries.count()<<"names -"
+            <<trigramMap.count()<<"trigrams";
+
+    QString longestName;
+    for(int id: sortedEntries)
+    {
+        if(entries[id].foldedName.length() > longestName.length())  longestName = entries[id].foldedName;
+    }
+    QString typoName = longestName;
+    if(typoName.length() > 4)   typoName.remove(typoName.length()/2, 2);
+
+    const int iterations = 100;
+    QStringList results;
+
+    timer.restart();
+    for(int i=0; i<iterations; i++)  results = exactCodes(longestName);
+    qDebug()<<"DEBUG NAME INDEX: Exact"<<longestName<<":"<<timer.nsecsElapsed()/iterations/1000<<"us -"<<results;
+
+    timer.restart();
+    for(int i=0; i<iterations; i++)  results = prefixCodes("a", sortedEntries.count());
+    qDebug()<<"DEBUG NAME INDEX: Prefix \"a\":"<<timer.nsecsElapsed()/iterations/1000<<"us -"<<results.count()<<"codes";
+
+    timer.restart();
+    for(int i=0; i<iterations; i++)  results = fuzzyCodes(typoName);
+    qDebug()<<"DEBUG NAME INDEX: Fuzzy"<<typoName<<":"<<timer.nsecsElapsed()/iterations/1000<<"us -"<<results;
+
+    timer.restart();
+    for(int i=0; i<iterations; i++)  results = fuzzyCodes("the");
+    qDebug()<<"DEBUG NAME INDEX: Fuzzy \"the\":"<<timer.nsecsElapsed()/iterations/1000<<"us -"<<results;
+
+    //Referencia: busqueda lineal como la antigua cardLocalCodeFromName
+    timer.restart();
+    QString foundCode;
+    for(QMap<QString, QJsonObject>::const_iterator it = cardsJson.cbegin(); it != cardsJson.cend(); it++)
+    {
+        QJsonObject namesObject = it->value("name").toObject();
+        for(const QString &lang: namesObject.keys())
+        {
+            if(foldName(namesObject.value(lang).toString()) == longestName)    foundCode = it.key();
+        }
+    }
+    qDebug()<<"DEBUG NAME INDEX: Linear scan"<<longestName<<":"<<timer.nsecsElapsed()/1000<<"us -"<<foundCode;
+}
@@ -0,0 +1,53 @@
+#ifndef CARDNAMEINDEX_H
+#define CARDNAMEINDEX_H
+
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QJsonObject>
+
+#define NAMEINDEX_FUZZY_MIN_SCORE 0.3
+
+
+//Indice de nombres de cartas (todos los idiomas) sin acentos ni mayusculas.
+//Permite busqueda exacta, por prefijo y aproximada (trigramas).
+class CardNameIndex
+{
+public:
+    CardNameIndex();
+
+private:
+    class NameEntry
+    {
+    public:
+        QString foldedName;
+        QString code;
+        int numTrigrams;
+    };
+
+//Variables
+private:
+    QVector<NameEntry> entries;
+    QHash<QString, QVector<int>> exactMap;
+    QVector<int> sortedEntries;//Solo cartas con coste, ordenadas por foldedName
+    QHash<quint64, QVector<int>> trigramMap;//Solo cartas con coste
+
+//Metodos
+private:
+    static QVector<quint64> getTrigrams(const QString &foldedName);
+    static void appendUnique(QStringList &codes, const QString &code, int maxResults);
+
+public:
+    void build(const QMap<QString, QJsonObject> &cardsJson);
+    void clear();
+    bool isEmpty() const;
+    QStringList exactCodes(const QString &name) const;
+    QStringList prefixCodes(const QString &prefix, int maxResults=20) const;
+    QStringList fuzzyCodes(const QString &name, int maxResults=10, double minScore=NAMEINDEX_FUZZY_MIN_SCORE) const;
+    void benchmark(const QMap<QString, QJsonObject> &cardsJson);
+    static QString foldName(const QString &name);
+};
+
+#endif // CARDNAMEINDEX_H
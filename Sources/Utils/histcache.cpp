@@ -0,0 +1,211 @@
+#include "histcache.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QtWidgets>
+
+
+HistCache::HistCache()
+{
+    this->loaded = false;
+    this->dirty = false;
+}
+
+
+void HistCache::setFilePath(const QString &filePath, const QString &imagesDir)
+{
+    this->filePath = filePath;
+    this->imagesDir = imagesDir;
+    this->loaded = false;
+    this->dirty = false;
+    entries.clear();
+}
+
+
+//El recorte de heroe (160x160) y el de carta (80x80) del mismo png generan histogramas distintos
+QString HistCache::key(const QString &code, bool heroCrop)
+{
+    return heroCrop?(code + "/hero"):code;
+}
+
+
+bool HistCache::fileStamp(const QString &imagePath, qint64 &mtime, qint64 &size)
+{
+    QFileInfo fileInfo(imagePath);
+    if(!fileInfo.exists())  return false;
+
+    mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+    size = fileInfo.size();
+    return true;
+}
+
+
+//Una unica lectura secuencial del fichero. Los histogramas se guardan dispersos (solo bins != 0).
+void HistCache::load()
+{
+    loaded = true;
+    entries.clear();
+    if(filePath.isEmpty())  return;
+
+    QFile file(filePath);
+    if(!file.exists())  return;
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qDebug()<<"HistCache: ERROR: Cannot open" << filePath;
+        return;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    QByteArray data = file.readAll();
+    file.close();
+
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic, version, count;
+    stream >> magic >> version >> count;
+    if(stream.status() != QDataStream::Ok || magic != HISTCACHE_MAGIC || version != HISTCACHE_VERSION)
+    {
+        qDebug()<<"HistCache: Ignoring old or invalid cache file.";
+        return;
+    }
+
+    entries.reserve(static_cast<int>(count));
+    for(quint32 i=0; i<count; i++)
+    {
+        QString key;
+        HistEntry entry;
+        qint32 rows, cols;
+        quint32 nonZero;
+        stream >> key >> entry.mtime >> entry.size >> rows >> cols >> nonZero;
+        if(stream.status() != QDataStream::Ok || rows <= 0 || cols <= 0 ||
+                nonZero > static_cast<quint32>(rows*cols))    break;
+
+        entry.hist = cv::MatND::zeros(rows, cols, CV_32F);
+        float *values = entry.hist.ptr<float>();
+        for(quint32 j=0; j<nonZero; j++)
+        {
+            quint16 index;
+            float value;
+            stream >> index >> value;
+            if(index < rows*cols)   values[index] = value;
+        }
+        if(stream.status() != QDataStream::Ok)  break;
+
+        entries[key] = entry;
+    }
+
+    checkStamps();
+    qDebug()<<"HistCache: Loaded" << entries.count() << "histograms in" << timer.elapsed() << "ms.";
+}
+
+
+//Un solo listado del directorio de imagenes en vez de un stat por carta en cada get
+void HistCache::checkStamps()
+{
+    QDir dir(imagesDir);
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.png");
+
+    QHash<QString, QPair<qint64, qint64>> stamps;
+    stamps.reserve(entries.count());
+    for(const QFileInfo &fileInfo: dir.entryInfoList())
+    {
+        stamps[fileInfo.completeBaseName()] = qMakePair(fileInfo.lastModified().toMSecsSinceEpoch(), fileInfo.size());
+    }
+
+    int removed = 0;
+    for(QHash<QString, HistEntry>::iterator it=entries.begin(); it!=entries.end();)
+    {
+        const QString code = it.key().split('/').first();
+        QHash<QString, QPair<qint64, qint64>>::const_iterator stamp = stamps.constFind(code);
+        if(stamp == stamps.constEnd() || stamp.value().first != it.value().mtime || stamp.value().second != it.value().size)
+        {
+            it = entries.erase(it);
+            removed++;
+        }
+        else    it++;
+    }
+
+    if(removed > 0)
+    {
+        dirty = true;
+        qDebug()<<"HistCache: Discarded" << removed << "outdated histograms.";
+    }
+}
+
+
+void HistCache::save()
+{
+    if(!dirty || filePath.isEmpty())    return;
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << static_cast<quint32>(HISTCACHE_MAGIC) << static_cast<quint32>(HISTCACHE_VERSION)
+           << static_cast<quint32>(entries.count());
+
+    for(QHash<QString, HistEntry>::const_iterator it=entries.constBegin(); it!=entries.constEnd(); it++)
+    {
+        const cv::MatND &hist = it.value().hist;
+        const float *values = hist.ptr<float>();
+        const int total = static_cast<int>(hist.total());
+
+        quint32 nonZero = 0;
+        for(int j=0; j<total; j++)  if(values[j] != 0)  nonZero++;
+
+        stream << it.key() << it.value().mtime << it.value().size
+               << static_cast<qint32>(hist.rows) << static_cast<qint32>(hist.cols) << nonZero;
+        for(int j=0; j<total; j++)
+        {
+            if(values[j] != 0)  stream << static_cast<quint16>(j) << values[j];
+        }
+    }
+
+    QFile file(filePath);
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qDebug()<<"HistCache: ERROR: Cannot write" << filePath;
+        return;
+    }
+    file.write(data);
+    file.close();
+    dirty = false;
+
+    qDebug()<<"HistCache: Saved" << entries.count() << "histograms.";
+}
+
+
+bool HistCache::get(const QString &code, bool heroCrop, cv::MatND &hist)
+{
+    if(!loaded) load();
+
+    QHash<QString, HistEntry>::const_iterator it = entries.constFind(key(code, heroCrop));
+    if(it == entries.constEnd())    return false;
+
+    hist = it.value().hist;
+    return true;
+}
+
+
+void HistCache::insert(const QString &code, bool heroCrop, const QString &imagePath, const cv::MatND &hist)
+{
+    if(!loaded) load();
+    if(hist.empty() || hist.type() != CV_32F || !hist.isContinuous() || hist.dims != 2)  return;
+
+    HistEntry entry;
+    if(!fileStamp(imagePath, entry.mtime, entry.size))  return;
+    entry.hist = hist;
+    entries[key(code, heroCrop)] = entry;
+    dirty = true;
+}
+
+
+void HistCache::invalidate(const QString &code)
+{
+    if(!loaded) load();
+    if(entries.remove(key(code, false)) + entries.remove(key(code, true)) > 0)  dirty = true;
+}
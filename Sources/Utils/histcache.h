@@ -0,0 +1,53 @@
+#ifndef HISTCACHE_H
+#define HISTCACHE_H
+
+#include <QString>
+#include <QHash>
+#include "opencv2/opencv.hpp"
+
+#define HISTCACHE_MAGIC     0x41544843
+#define HISTCACHE_VERSION   1
+
+
+//Cache en disco de los histogramas HSV de las imagenes de cartas (hscards).
+//Cada entrada guarda el mtime y tamano del png; al cargar el fichero se comparan con un unico
+//listado del directorio y se descartan las que no coinciden. Durante la sesion las imagenes
+//reemplazadas se quitan con invalidate, asi get es solo una busqueda en el hash.
+class HistCache
+{
+public:
+    HistCache();
+
+private:
+    class HistEntry
+    {
+    public:
+        qint64 mtime;
+        qint64 size;
+        cv::MatND hist;
+    };
+
+//Variables
+private:
+    QHash<QString, HistEntry> entries;
+    QString filePath;
+    QString imagesDir;
+    bool loaded;
+    bool dirty;
+
+//Metodos
+private:
+    static QString key(const QString &code, bool heroCrop);
+    static bool fileStamp(const QString &imagePath, qint64 &mtime, qint64 &size);
+    void load();
+    void checkStamps();
+
+public:
+    bool get(const QString &code, bool heroCrop, cv::MatND &hist);
+    void insert(const QString &code, bool heroCrop, const QString &imagePath, const cv::MatND &hist);
+    void invalidate(const QString &code);
+    void save();
+    void setFilePath(const QString &filePath, const QString &imagesDir);
+};
+
+#endif // HISTCACHE_H
@@ -0,0 +1,323 @@
+#include "hsvhist.h"
+#include <QDir>
+#include <QElapsedTimer>
+#include <QtWidgets>
+#include <algorithm>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HSVHIST_X86_SIMD
+#include <immintrin.h>
+#endif
+
+#define HSV_SHIFT           12
+#define HSV_HALF            (1 << (HSV_SHIFT-1))
+#define HSVHIST_DISCARD     HSVHIST_TOTAL   //h == 180 queda fuera del rango [0,180) de calcHist
+
+
+namespace
+{
+enum HsvHistPath {HsvOpenCV, HsvScalar, HsvSse41, HsvAvx2};
+
+
+//Tablas de cvtColor(BGR2HSV) de 8 bits y bins de calcHist
+class HsvHistTables
+{
+public:
+    int sdiv[256];
+    int hdiv[256];
+    int hOffset[256];   //Bin H * HSVHIST_S_BINS o HSVHIST_DISCARD
+    int sBin[256];
+
+    HsvHistTables()
+    {
+        sdiv[0] = hdiv[0] = 0;
+        for(int i=1; i<256; i++)
+        {
+            sdiv[i] = cv::saturate_cast<int>((255 << HSV_SHIFT)/(1.*i));
+            hdiv[i] = cv::saturate_cast<int>((180 << HSV_SHIFT)/(6.*i));
+        }
+
+        //Mismo redondeo que calcHist con rangos uniformes
+        const double hScale = HSVHIST_H_BINS/180.0;
+        const double sScale = HSVHIST_S_BINS/256.0;
+        for(int i=0; i<256; i++)
+        {
+            int hBin = cvFloor(i*hScale);
+            hOffset[i] = (hBin < HSVHIST_H_BINS)?(hBin*HSVHIST_S_BINS):HSVHIST_DISCARD;
+            sBin[i] = std::min(cvFloor(i*sScale), HSVHIST_S_BINS-1);
+        }
+    }
+};
+
+
+const HsvHistTables &tables()
+{
+    static const HsvHistTables hsvHistTables;
+    return hsvHistTables;
+}
+
+
+HsvHistPath bestPath()
+{
+#ifdef HSVHIST_X86_SIMD
+    static const HsvHistPath path = __builtin_cpu_supports("avx2")?HsvAvx2:
+                                    (__builtin_cpu_supports("sse4.1")?HsvSse41:HsvScalar);
+    return path;
+#else
+    return HsvScalar;
+#endif
+}
+
+
+//RGB2HSV_b de OpenCV, devuelve el indice del bin
+inline int hsvBin(const HsvHistTables &t, int b, int g, int r)
+{
+    int v = std::max(b, std::max(g, r));
+    int vmin = std::min(b, std::min(g, r));
+    int diff = v - vmin;
+    int vr = (v == r) ? -1 : 0;
+    int vg = (v == g) ? -1 : 0;
+
+    int s = (diff * t.sdiv[v] + HSV_HALF) >> HSV_SHIFT;
+    int h = (vr & (g - b)) + (~vr & ((vg & (b - r + 2*diff)) + ((~vg) & (r - g + 4*diff))));
+    h = (h * t.hdiv[diff] + HSV_HALF) >> HSV_SHIFT;
+    h += (h < 0) ? 180 : 0;
+
+    return t.hOffset[h] + t.sBin[s];
+}
+
+
+void accumulateRowScalar(const uchar *row, int x, int cols, int cn, int *counts)
+{
+    const HsvHistTables &t = tables();
+    for(const uchar *p = row + x*cn; x<cols; x++, p+=cn)
+    {
+        counts[hsvBin(t, p[0], p[1], p[2])]++;
+    }
+}
+
+
+#ifdef HSVHIST_X86_SIMD
+//4 pixeles por iteracion en lanes de 32 bits. Sin gather, las tablas se leen de forma escalar.
+//Con 3 canales cada pixel se lee como 4 bytes: el ultimo bloque nunca incluye el ultimo pixel de la fila.
+__attribute__((target("sse4.1")))
+int accumulateRowSse41(const uchar *row, int cols, int cn, int *counts)
+{
+    const HsvHistTables &t = tables();
+    const __m128i mask8 = _mm_set1_epi32(0xFF);
+    const __m128i half = _mm_set1_epi32(HSV_HALF);
+    const __m128i hr = _mm_set1_epi32(180);
+    const __m128i zero = _mm_setzero_si128();
+    alignas(16) int lanes[4], hLanes[4], sLanes[4];
+
+    int x = 0;
+    const int end = (cn == 4) ? cols - 3 : cols - 4;
+    for(; x<end; x+=4)
+    {
+        const uchar *p = row + x*cn;
+        __m128i px;
+        if(cn == 4)     px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        else
+        {
+            int pixels[4];
+            for(int i=0; i<4; i++)  memcpy(&pixels[i], p + i*3, 4);
+            px = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+        }
+
+        __m128i b = _mm_and_si128(px, mask8);
+        __m128i g = _mm_and_si128(_mm_srli_epi32(px, 8), mask8);
+        __m128i r = _mm_and_si128(_mm_srli_epi32(px, 16), mask8);
+        __m128i v = _mm_max_epi32(b, _mm_max_epi32(g, r));
+        __m128i diff = _mm_sub_epi32(v, _mm_min_epi32(b, _mm_min_epi32(g, r)));
+        __m128i vr = _mm_cmpeq_epi32(v, r);
+        __m128i vg = _mm_cmpeq_epi32(v, g);
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), v);
+        __m128i sdiv = _mm_setr_epi32(t.sdiv[lanes[0]], t.sdiv[lanes[1]], t.sdiv[lanes[2]], t.sdiv[lanes[3]]);
+        __m128i s = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(diff, sdiv), half), HSV_SHIFT);
+
+        __m128i diff2 = _mm_add_epi32(diff, diff);
+        __m128i hMaxG = _mm_add_epi32(_mm_sub_epi32(b, r), diff2);
+        __m128i hMaxB = _mm_add_epi32(_mm_sub_epi32(r, g), _mm_add_epi32(diff2, diff2));
+        __m128i h = _mm_add_epi32(_mm_and_si128(vg, hMaxG), _mm_andnot_si128(vg, hMaxB));
+        h = _mm_add_epi32(_mm_and_si128(vr, _mm_sub_epi32(g, b)), _mm_andnot_si128(vr, h));
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), diff);
+        __m128i hdiv = _mm_setr_epi32(t.hdiv[lanes[0]], t.hdiv[lanes[1]], t.hdiv[lanes[2]], t.hdiv[lanes[3]]);
+        h = _mm_srai_epi32(_mm_add_epi32(_mm_mullo_epi32(h, hdiv), half), HSV_SHIFT);
+        h = _mm_add_epi32(h, _mm_and_si128(_mm_cmpgt_epi32(zero, h), hr));
+
+        _mm_store_si128(reinterpret_cast<__m128i*>(hLanes), h);
+        _mm_store_si128(reinterpret_cast<__m128i*>(sLanes), s);
+        for(int i=0; i<4; i++)  counts[t.hOffset[hLanes[i]] + t.sBin[sLanes[i]]]++;
+    }
+    return x;
+}
+
+
+//8 pixeles por iteracion; tablas y bins con gather
+__attribute__((target("avx2")))
+int accumulateRowAvx2(const uchar *row, int cols, int cn, int *counts)
+{
+    const HsvHistTables &t = tables();
+    const __m256i mask8 = _mm256_set1_epi32(0xFF);
+    const __m256i half = _mm256_set1_epi32(HSV_HALF);
+    const __m256i hr = _mm256_set1_epi32(180);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i offsets3 = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    alignas(32) int bins[8];
+
+    int x = 0;
+    const int end = (cn == 4) ? cols - 7 : cols - 8;
+    for(; x<end; x+=8)
+    {
+        const uchar *p = row + x*cn;
+        __m256i px = (cn == 4) ? _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)) :
+                                 _mm256_i32gather_epi32(reinterpret_cast<const int*>(p), offsets3, 1);
+
+        __m256i b = _mm256_and_si256(px, mask8);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(px, 8), mask8);
+        __m256i r = _mm256_and_si256(_mm256_srli_epi32(px, 16), mask8);
+        __m256i v = _mm256_max_epi32(b, _mm256_max_epi32(g, r));
+        __m256i diff = _mm256_sub_epi32(v, _mm256_min_epi32(b, _mm256_min_epi32(g, r)));
+        __m256i vr = _mm256_cmpeq_epi32(v, r);
+        __m256i vg = _mm256_cmpeq_epi32(v, g);
+
+        __m256i sdiv = _mm256_i32gather_epi32(t.sdiv, v, 4);
+        __m256i s = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(diff, sdiv), half), HSV_SHIFT);
+
+        __m256i diff2 = _mm256_add_epi32(diff, diff);
+        __m256i hMaxG = _mm256_add_epi32(_mm256_sub_epi32(b, r), diff2);
+        __m256i hMaxB = _mm256_add_epi32(_mm256_sub_epi32(r, g), _mm256_add_epi32(diff2, diff2));
+        __m256i h = _mm256_add_epi32(_mm256_and_si256(vg, hMaxG), _mm256_andnot_si256(vg, hMaxB));
+        h = _mm256_add_epi32(_mm256_and_si256(vr, _mm256_sub_epi32(g, b)), _mm256_andnot_si256(vr, h));
+
+        __m256i hdiv = _mm256_i32gather_epi32(t.hdiv, diff, 4);
+        h = _mm256_srai_epi32(_mm256_add_epi32(_mm256_mullo_epi32(h, hdiv), half), HSV_SHIFT);
+        h = _mm256_add_epi32(h, _mm256_and_si256(_mm256_cmpgt_epi32(zero, h), hr));
+
+        __m256i bin = _mm256_add_epi32(_mm256_i32gather_epi32(t.hOffset, h, 4), _mm256_i32gather_epi32(t.sBin, s, 4));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(bins), bin);
+        for(int i=0; i<8; i++)  counts[bins[i]]++;
+    }
+    return x;
+}
+#endif
+
+
+cv::MatND calcHistWithPath(const cv::Mat &src, HsvHistPath path)
+{
+    if(path == HsvOpenCV || src.empty() || src.depth() != CV_8U || (src.channels() != 3 && src.channels() != 4))
+    {
+        return HsvHist::calcHistOpenCV(src);
+    }
+
+    //HSVHIST_S_BINS extra para los pixeles descartados
+    int counts[HSVHIST_TOTAL + HSVHIST_S_BINS] = {};
+    const int cn = src.channels();
+    for(int y=0; y<src.rows; y++)
+    {
+        const uchar *row = src.ptr<uchar>(y);
+        int x = 0;
+#ifdef HSVHIST_X86_SIMD
+        if(path == HsvAvx2)         x = accumulateRowAvx2(row, src.cols, cn, counts);
+        else if(path == HsvSse41)   x = accumulateRowSse41(row, src.cols, cn, counts);
+#endif
+        accumulateRowScalar(row, x, src.cols, cn, counts);
+    }
+
+    cv::MatND hist(HSVHIST_H_BINS, HSVHIST_S_BINS, CV_32F);
+    float *values = hist.ptr<float>();
+    for(int i=0; i<HSVHIST_TOTAL; i++)  values[i] = static_cast<float>(counts[i]);
+    normalize(hist, hist, 0, 1, cv::NORM_MINMAX, -1, cv::Mat());
+    return hist;
+}
+
+
+void benchmarkPath(const char *name, HsvHistPath path, const std::vector<cv::Mat> &crops, int iterations)
+{
+    QElapsedTimer timer;
+    timer.start();
+    for(int i=0; i<iterations; i++)
+    {
+        for(const cv::Mat &crop: crops)     calcHistWithPath(crop, path);
+    }
+    const qint64 nsecs = timer.nsecsElapsed();
+
+    double maxDiff = 0;
+    for(const cv::Mat &crop: crops)
+    {
+        maxDiff = std::max(maxDiff, cv::norm(calcHistWithPath(crop, path), HsvHist::calcHistOpenCV(crop), cv::NORM_INF));
+    }
+
+    qDebug()<<"DEBUG HSVHIST:"<<name<<":"<<nsecs/iterations/static_cast<qint64>(crops.size())/1000.0<<"us/crop -"
+            <<"max diff vs OpenCV"<<maxDiff;
+}
+}
+
+
+cv::MatND HsvHist::calcHist(const cv::Mat &src)
+{
+    return calcHistWithPath(src, bestPath());
+}
+
+
+//cvtColor + calcHist + normalize, la implementacion de referencia
+cv::MatND HsvHist::calcHistOpenCV(const cv::Mat &src)
+{
+    cv::Mat hsvBase;
+    cvtColor(src, hsvBase, cv::COLOR_BGR2HSV);
+
+    int histSize[] = {HSVHIST_H_BINS, HSVHIST_S_BINS};
+    float h_ranges[] = {0, 180};
+    float s_ranges[] = {0, 256};
+    const float* ranges[] = {h_ranges, s_ranges};
+    int channels[] = {0, 1};
+
+    cv::MatND histBase;
+    cv::calcHist(&hsvBase, 1, channels, cv::Mat(), histBase, 2, histSize, ranges, true, false);
+    normalize(histBase, histBase, 0, 1, cv::NORM_MINMAX, -1, cv::Mat());
+    return histBase;
+}
+
+
+//Recortes de carta (80x80) de los png de imagesDir, en BGR (imagenes de referencia) y BGRA (capturas)
+void HsvHist::benchmark(const QString &imagesDir, int maxImages)
+{
+    std::vector<cv::Mat> crops, cropsBGRA;
+    const QStringList files = QDir(imagesDir).entryList(QStringList() << "*.png", QDir::Files);
+    for(const QString &file: files)
+    {
+        if(static_cast<int>(crops.size()) >= maxImages)  break;
+
+        cv::Mat fullCard = cv::imread((imagesDir + "/" + file).toStdString(), CV_LOAD_IMAGE_COLOR);
+        if(fullCard.cols < 140 || fullCard.rows < 151)  continue;
+        cv::Mat crop = fullCard(cv::Rect(60,71,80,80));
+        cv::Mat cropBGRA;
+        cvtColor(crop, cropBGRA, CV_BGR2BGRA);
+        crops.push_back(crop);
+        cropsBGRA.push_back(cropBGRA);
+    }
+
+    if(crops.empty())
+    {
+        qDebug()<<"DEBUG HSVHIST: No card images in"<<imagesDir;
+        return;
+    }
+    qDebug()<<"DEBUG HSVHIST:"<<crops.size()<<"crops 80x80 - Best path:"<<
+              (bestPath()==HsvAvx2?"AVX2":(bestPath()==HsvSse41?"SSE4.1":"Scalar"));
+
+    const int iterations = 20;
+    for(int i=0; i<2; i++)
+    {
+        const std::vector<cv::Mat> &cropsSet = (i == 0) ? crops : cropsBGRA;
+        qDebug()<<"DEBUG HSVHIST:"<<((i == 0) ? "BGR" : "BGRA");
+        benchmarkPath("OpenCV", HsvOpenCV, cropsSet, iterations);
+        benchmarkPath("Scalar", HsvScalar, cropsSet, iterations);
+#ifdef HSVHIST_X86_SIMD
+        if(__builtin_cpu_supports("sse4.1"))    benchmarkPath("SSE4.1", HsvSse41, cropsSet, iterations);
+        if(__builtin_cpu_supports("avx2"))      benchmarkPath("AVX2", HsvAvx2, cropsSet, iterations);
+#endif
+    }
+}
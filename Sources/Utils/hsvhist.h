@@ -0,0 +1,24 @@
+#ifndef HSVHIST_H
+#define HSVHIST_H
+
+#include <QString>
+#include "opencv2/opencv.hpp"
+
+#define HSVHIST_H_BINS      50
+#define HSVHIST_S_BINS      60
+#define HSVHIST_TOTAL       (HSVHIST_H_BINS*HSVHIST_S_BINS)
+
+
+//Histograma H/S (50x60, normalizado MINMAX) de una imagen BGR o BGRA en una sola pasada:
+//convierte cada pixel a H/S con la misma aritmetica entera que cvtColor(BGR2HSV) y acumula el bin
+//directamente, sin crear el Mat HSV. El resultado es identico a cvtColor + calcHist + normalize.
+//Usa AVX2 o SSE4.1 si la CPU lo soporta (x86 con GCC/Clang) y si no la version escalar.
+class HsvHist
+{
+public:
+    static cv::MatND calcHist(const cv::Mat &src);
+    static cv::MatND calcHistOpenCV(const cv::Mat &src);
+    static void benchmark(const QString &imagesDir, int maxImages=200);
+};
+
+#endif // HSVHIST_H
@@ -0,0 +1,301 @@
+#include "tierstore.h"
+#include <QFile>
+#include <QFileInfo>
+#include <QDataStream>
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QtWidgets>
+#include <climits>
+
+
+TierStore::TierStore()
+{
+    this->loaded = false;
+    this->complete = false;
+}
+
+
+QString TierStore::storePath()
+{
+    return Utility::extraPath() + "/tierStore.dat";
+}
+
+
+TierStore::FileStamp TierStore::getFileStamp(const QString &path)
+{
+    FileStamp stamp;
+    QFileInfo fileInfo(path);
+    if(fileInfo.exists())
+    {
+        stamp.mtime = fileInfo.lastModified().toMSecsSinceEpoch();
+        stamp.size = fileInfo.size();
+    }
+    return stamp;
+}
+
+
+//Un store sin HearthArena (construido sin cardsJson) sigue valido hasta que se cargue cardsJson
+bool TierStore::isUpToDate(const FileStamp &lfFileStamp, const FileStamp &haFileStamp)
+{
+    return loaded && lfStamp == lfFileStamp && haStamp == haFileStamp &&
+            (complete || !Utility::isCardsJsonLoaded());
+}
+
+
+//Borra el store; se reconstruira en el siguiente update (nuevo lightForge.json/hearthArena.json)
+void TierStore::reset()
+{
+    entries.clear();
+    codeIndex.clear();
+    loaded = complete = false;
+    QFile::remove(storePath());
+}
+
+
+//Unico punto que comprueba los ficheros (al iniciar un draft o cambiar las tier lists).
+//Los getters solo consultan lo ya cargado.
+void TierStore::update()
+{
+    FileStamp lfFileStamp = getFileStamp(Utility::extraPath() + "/lightForge.json");
+    FileStamp haFileStamp = getFileStamp(Utility::extraPath() + "/hearthArena.json");
+
+    if(isUpToDate(lfFileStamp, haFileStamp))    return;
+    if(load() && isUpToDate(lfFileStamp, haFileStamp))  return;
+
+    build(lfFileStamp, haFileStamp);
+    if(complete)    save();
+}
+
+
+bool TierStore::load()
+{
+    QFile file(storePath());
+    if(!file.exists() || !file.open(QIODevice::ReadOnly))   return false;
+    QByteArray data = file.readAll();
+    file.close();
+
+    QDataStream stream(data);
+    quint32 magic, version, count;
+    FileStamp lfFileStamp, haFileStamp;
+    stream >> magic >> version >> lfFileStamp.mtime >> lfFileStamp.size >> haFileStamp.mtime >> haFileStamp.size >> count;
+    if(stream.status() != QDataStream::Ok || magic != TIERSTORE_MAGIC || version != TIERSTORE_VERSION)    return false;
+
+    QVector<TierEntry> loadedEntries;
+    loadedEntries.reserve(static_cast<int>(count));
+    for(quint32 i=0; i<count; i++)
+    {
+        TierEntry entry;
+        qint32 score, maxCard;
+        stream >> entry.code >> entry.lfMask >> entry.haMask;
+        for(int c=0; c<NUM_HEROS; c++)
+        {
+            stream >> score >> maxCard;
+            entry.lfTiers[c].score = score;
+            entry.lfTiers[c].maxCard = maxCard;
+        }
+        stream >> score >> maxCard;
+        entry.lfMultiTier.score = score;
+        entry.lfMultiTier.maxCard = maxCard;
+        for(int c=0; c<NUM_HEROS; c++)
+        {
+            stream >> score;
+            entry.haScores[c] = score;
+        }
+        if(stream.status() != QDataStream::Ok)  return false;
+        loadedEntries.append(entry);
+    }
+
+    entries = loadedEntries;
+    codeIndex.clear();
+    for(int i=0; i<entries.count(); i++)    codeIndex[entries[i].code] = i;
+    lfStamp = lfFileStamp;
+    haStamp = haFileStamp;
+    loaded = complete = true;
+    return true;
+}
+
+
+void TierStore::save()
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << static_cast<quint32>(TIERSTORE_MAGIC) << static_cast<quint32>(TIERSTORE_VERSION)
+           << lfStamp.mtime << lfStamp.size << haStamp.mtime << haStamp.size
+           << static_cast<quint32>(entries.count());
+
+    for(const TierEntry &entry: entries)
+    {
+        stream << entry.code << entry.lfMask << entry.haMask;
+        for(int c=0; c<NUM_HEROS; c++)
+        {
+            stream << static_cast<qint32>(entry.lfTiers[c].score) << static_cast<qint32>(entry.lfTiers[c].maxCard);
+        }
+        stream << static_cast<qint32>(entry.lfMultiTier.score) << static_cast<qint32>(entry.lfMultiTier.maxCard);
+        for(int c=0; c<NUM_HEROS; c++)  stream << static_cast<qint32>(entry.haScores[c]);
+    }
+
+    QFile file(storePath());
+    if(!file.open(QIODevice::WriteOnly))
+    {
+        qDebug()<<"TierStore: ERROR: Cannot write" << storePath();
+        return;
+    }
+    file.write(data);
+    file.close();
+}
+
+
+void TierStore::build(const FileStamp &lfFileStamp, const FileStamp &haFileStamp)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    entries.clear();
+    codeIndex.clear();
+    lfStamp = lfFileStamp;
+    haStamp = haFileStamp;
+    buildLightForge();
+    buildHearthArena();
+    loaded = true;
+
+    qDebug()<<"TierStore: Built" << entries.count() << "cards in" << timer.elapsed() << "ms." <<
+              (complete?"":"(without HearthArena)");
+}
+
+
+void TierStore::buildLightForge()
+{
+    QString heroNames[NUM_HEROS];
+    for(int c=0; c<NUM_HEROS; c++)  heroNames[c] = Utility::classOrder2classUL_ULName(c);
+
+    QFile jsonFile(Utility::extraPath() + "/lightForge.json");
+    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
+    jsonFile.close();
+    const QJsonArray jsonCardsArray = jsonDoc.object().value("Cards").toArray();
+    for(QJsonValue jsonCard: jsonCardsArray)
+    {
+        QJsonObject jsonCardObject = jsonCard.toObject();
+        TierEntry entry;
+        entry.code = jsonCardObject.value("CardId").toString();
+
+        bool firstScore = true;
+        const QJsonArray jsonScoresArray = jsonCardObject.value("Scores").toArray();
+        for(QJsonValue jsonScore: jsonScoresArray)
+        {
+            QJsonObject jsonScoreObject = jsonScore.toObject();
+            QString hero = jsonScoreObject.value("Hero").toString();
+
+            LFtier lfTier;
+            lfTier.score = static_cast<int>(jsonScoreObject.value("Score").toDouble());
+            if(jsonScoreObject.value("StopAfterFirst").toBool())        lfTier.maxCard = 1;
+            else if(jsonScoreObject.value("StopAfterSecond").toBool())  lfTier.maxCard = 2;
+            else                                                        lfTier.maxCard = -1;
+
+            //En multiclass guardaremos el primer score que aparezca
+            if(firstScore)
+            {
+                entry.lfMultiTier = lfTier;
+                firstScore = false;
+            }
+
+            //En uniclass guardaremos el ultimo score neutral (hero == nullptr) o de la clase
+            for(int c=0; c<NUM_HEROS; c++)
+            {
+                if(hero == nullptr || hero == heroNames[c])
+                {
+                    entry.lfTiers[c] = lfTier;
+                    entry.lfMask |= (1 << c);
+                }
+            }
+        }
+
+        //Sin scores: solo forma parte de getCodes()
+        if(firstScore)  entry.lfMultiTier.score = INT_MIN;
+
+        if(codeIndex.contains(entry.code))  continue;
+        codeIndex[entry.code] = entries.count();
+        entries.append(entry);
+    }
+}
+
+
+void TierStore::buildHearthArena()
+{
+    complete = Utility::isCardsJsonLoaded();
+    if(!complete)   return;
+
+    QFile jsonFile(Utility::extraPath() + "/hearthArena.json");
+    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
+    jsonFile.close();
+
+    QJsonObject heroJsonObjects[NUM_HEROS];
+    for(int c=0; c<NUM_HEROS; c++)
+    {
+        heroJsonObjects[c] = jsonDoc.object().value(Utility::classOrder2classUL_ULName(c)).toObject();
+    }
+
+    for(TierEntry &entry: entries)
+    {
+        QString name = Utility::cardEnNameFromCode(entry.code);
+        for(int c=0; c<NUM_HEROS; c++)
+        {
+            QJsonObject::const_iterator it = heroJsonObjects[c].constFind(name);
+            if(it != heroJsonObjects[c].constEnd())
+            {
+                entry.haScores[c] = it.value().toInt();
+                entry.haMask |= (1 << c);
+            }
+        }
+    }
+}
+
+
+//Todas las cartas de lightForge.json, en el orden del fichero
+QStringList TierStore::getCodes()
+{
+    QStringList codes;
+    codes.reserve(entries.count());
+    for(const TierEntry &entry: entries)    codes.append(entry.code);
+    return codes;
+}
+
+
+QMap<QString, LFtier> TierStore::getLightForgeTiers(CardClass heroClass, bool multiClassDraft)
+{
+    QMap<QString, LFtier> lightForgeTiers;
+    const int c = static_cast<int>(heroClass);
+    for(const TierEntry &entry: entries)
+    {
+        if(multiClassDraft)
+        {
+            if(entry.lfMultiTier.score != INT_MIN)  lightForgeTiers[entry.code] = entry.lfMultiTier;
+        }
+        else if(c >= 0 && c < NUM_HEROS && (entry.lfMask & (1 << c)))
+        {
+            lightForgeTiers[entry.code] = entry.lfTiers[c];
+        }
+    }
+    return lightForgeTiers;
+}
+
+
+//Multiclass: score de la clase del draft o el de la primera otra clase que tenga la carta
+int TierStore::getHearthArenaScore(const QString &code, CardClass heroClass, bool multiClassDraft)
+{
+    QHash<QString, int>::const_iterator it = codeIndex.constFind(code);
+    if(it == codeIndex.constEnd())  return 0;
+    const TierEntry &entry = entries[it.value()];
+
+    const int c = static_cast<int>(heroClass);
+    if(c >= 0 && c < NUM_HEROS && (entry.haMask & (1 << c)))    return entry.haScores[c];
+    if(!multiClassDraft)    return 0;
+
+    for(int j=0; j<NUM_HEROS; j++)
+    {
+        if(j != c && (entry.haMask & (1 << j)))     return entry.haScores[j];
+    }
+    return 0;
+}
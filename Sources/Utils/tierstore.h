@@ -0,0 +1,79 @@
+#ifndef TIERSTORE_H
+#define TIERSTORE_H
+
+#include "../utility.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+
+#define TIERSTORE_MAGIC     0x41545453
+#define TIERSTORE_VERSION   1
+
+
+class LFtier
+{
+public:
+    int score = 0;
+    int maxCard = -1;
+};
+
+
+//Tier lists de LightForge y HearthArena preprocesadas por carta y clase.
+//Se construye una vez desde lightForge.json y hearthArena.json y se guarda en tierStore.dat.
+//update() carga o reconstruye el store; el resto de metodos no accede a disco.
+class TierStore
+{
+public:
+    TierStore();
+
+private:
+    class TierEntry
+    {
+    public:
+        QString code;
+        quint16 lfMask = 0;             //Clases (uniclass) con score LF
+        LFtier lfTiers[NUM_HEROS];      //Ultimo score neutral/de la clase (uniclass)
+        LFtier lfMultiTier;             //Primer score de la carta (multiclass)
+        quint16 haMask = 0;             //Clases con score HA
+        int haScores[NUM_HEROS] = {};
+    };
+
+    class FileStamp
+    {
+    public:
+        qint64 mtime = -1;
+        qint64 size = -1;
+        bool operator==(const FileStamp &other) const {return mtime == other.mtime && size == other.size;}
+        bool operator!=(const FileStamp &other) const {return !(*this == other);}
+    };
+
+//Variables
+private:
+    QVector<TierEntry> entries;
+    QHash<QString, int> codeIndex;
+    FileStamp lfStamp, haStamp;
+    bool loaded;
+    bool complete;//Falso si se construyo sin cardsJson (sin HearthArena)
+
+//Metodos
+private:
+    static FileStamp getFileStamp(const QString &path);
+    static QString storePath();
+    bool isUpToDate(const FileStamp &lfFileStamp, const FileStamp &haFileStamp);
+    bool load();
+    void save();
+    void build(const FileStamp &lfFileStamp, const FileStamp &haFileStamp);
+    void buildLightForge();
+    void buildHearthArena();
+
+public:
+    void reset();
+    void update();
+    QStringList getCodes();
+    QMap<QString, LFtier> getLightForgeTiers(CardClass heroClass, bool multiClassDraft);
+    int getHearthArenaScore(const QString &code, CardClass heroClass, bool multiClassDraft);
+};
+
+#endif // TIERSTORE_H
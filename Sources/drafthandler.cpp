@@ -2,6 +2,7 @@
 #include "themehandler.h"
 #include <QtConcurrent/QtConcurrent>
 #include <QtWidgets>
+#include <algorithm>
 
 DraftHandler::DraftHandler(QObject *parent, Ui::Extended *ui, DeckHandler *deckHandler, ArenaHandler *arenaHandler) : QObject(parent)
 {
@@ -34,6 +35,10 @@ DraftHandler::DraftHandler(QObject *parent, Ui::Extended *ui, DeckHandler *deckH
     this->cardsIncludedWinratesMap = nullptr;
     this->cardsIncludedDecksMap = nullptr;
     this->cardsPlayedWinratesMap = nullptr;
+    this->cardsPickratesMap = nullptr;
+    this->lookaheadScoreScale = 1;
+    this->cardsHistMatrixOutdated = true;
+    this->histCache.setFilePath(Utility::extraPath() + "/histograms.dat", Utility::hscardsPath());
 
     for(int i=0; i<3; i++)
     {
@@ -46,6 +51,9 @@ DraftHandler::DraftHandler(QObject *parent, Ui::Extended *ui, DeckHandler *deckH
     completeUI();
 
     connect(&futureFindScreenRects, SIGNAL(finished()), this, SLOT(finishFindScreenRects()));
+    connect(&futureCaptureDraft, SIGNAL(finished()), this, SLOT(finishCaptureDraft()));
+    connect(&futureHeroesHist, SIGNAL(finished()), this, SLOT(finishHeroesHist()));
+    connect(&futureLookahead, SIGNAL(finished()), this, SLOT(finishLookahead()));
 }
 
 DraftHandler::~DraftHandler()
@@ -55,6 +63,7 @@ DraftHandler::~DraftHandler()
     deleteDraftMechanicsWindow();
     deleteTwitchHandler();
     if(synergyHandler != nullptr)  delete synergyHandler;
+    histCache.save();
 }
 
 
@@ -203,21 +212,16 @@ void DraftHandler::clearAndDisconnectComboBox(int index)
 
 QStringList DraftHandler::getAllArenaCodes()
 {
-    QStringList codeList;
+    tierStore.update();
+    return tierStore.getCodes();
+}
 
-    QFile jsonFile(Utility::extraPath() + "/lightForge.json");
-    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
-    jsonFile.close();
-    const QJsonArray jsonCardsArray = jsonDoc.object().value("Cards").toArray();
-    for(QJsonValue jsonCard: jsonCardsArray)
-    {
-        QJsonObject jsonCardObject = jsonCard.toObject();
-        QString code = jsonCardObject.value("CardId").toString();
-        codeList.append(code);
-    }
 
-    return codeList;
+//Nuevo lightForge.json/hearthArena.json
+void DraftHandler::updateTierStore()
+{
+    tierStore.reset();
+    if(Utility::isCardsJsonLoaded())    tierStore.update();
 }
 
 
@@ -227,61 +231,21 @@ QStringList DraftHandler::getAllHeroCodes()
 }
 
 
-void DraftHandler::initHearthArenaTiers(const QString &heroString, const bool multiClassDraft)
+void DraftHandler::initHearthArenaTiers(const CardClass heroClass, const bool multiClassDraft)
 {
     hearthArenaTiers.clear();
 
-    QFile jsonFile(Utility::extraPath() + "/hearthArena.json");
-    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
-    jsonFile.close();
-
-    if(multiClassDraft)
-    {
-        QJsonObject heroJsonObject = jsonDoc.object().value(heroString).toObject();
-        QJsonObject othersJsonObject[NUM_HEROS-1];
-        for(int j=0, i=0; j<NUM_HEROS; j++)
-        {
-            if(heroString != Utility::classOrder2classUL_ULName(j))
-            {
-                othersJsonObject[i++] = jsonDoc.object().value(Utility::classOrder2classUL_ULName(j)).toObject();
-            }
-        }
-        for(const QString &code: lightForgeTiers.keys())
-        {
-            QString name = Utility::cardEnNameFromCode(code);
-            if(heroJsonObject.contains(name))   hearthArenaTiers[code] = heroJsonObject.value(name).toInt();
-            else
-            {
-                for(int i=0; i<(NUM_HEROS-1); i++)
-                {
-                    if(othersJsonObject[i].contains(name))
-                    {
-                        hearthArenaTiers[code] = othersJsonObject[i].value(name).toInt();
-                        break;
-                    }
-                }
-            }
-
-            if(hearthArenaTiers[code] == 0)  emit pDebug("HearthArena missing: " + name);
-        }
-    }
-    else
+    for(const QString &code: lightForgeTiers.keys())
     {
-        QJsonObject jsonNamesObject = jsonDoc.object().value(heroString).toObject();
-        for(const QString &code: lightForgeTiers.keys())
-        {
-            QString name = Utility::cardEnNameFromCode(code);
-            int score = jsonNamesObject.value(name).toInt();
-            hearthArenaTiers[code] = score;
-            if(score == 0)  emit pDebug("HearthArena missing: " + name);
-        }
-        emit pDebug("HearthArena Cards: " + QString::number(jsonNamesObject.count()));
+        int score = tierStore.getHearthArenaScore(code, heroClass, multiClassDraft);
+        hearthArenaTiers[code] = score;
+        if(score == 0)  emit pDebug("HearthArena missing: " + Utility::cardEnNameFromCode(code));
     }
+    emit pDebug("HearthArena Cards: " + QString::number(hearthArenaTiers.count()));
 }
 
 
-void DraftHandler::addCardHist(QString code, bool premium, bool isHero)
+void DraftHandler::addCardHist(QString code, bool premium, bool isHero, bool download)
 {
     //Evitamos golden cards de cartas no colleccionables
     if(premium &&
@@ -289,12 +253,12 @@ void DraftHandler::addCardHist(QString code, bool premium, bool isHero)
          !Utility::getCardAttribute(code, "collectible").toBool())) return;
 
     QString fileNameCode = premium?(code + "_premium"): code;
-    QFileInfo cardFile(Utility::hscardsPath() + "/" + fileNameCode + ".png");
-    if(cardFile.exists())
+    if(Utility::cardImageExists(fileNameCode))
     {
         cardsHist[fileNameCode] = getHist(fileNameCode);
+        cardsHistMatrixOutdated = true;
     }
-    else
+    else if(download)
     {
         //La bajamos de github/hearthSim
         emit checkCardImage(fileNameCode, isHero);
@@ -303,61 +267,18 @@ void DraftHandler::addCardHist(QString code, bool premium, bool isHero)
 }
 
 
-QMap<QString, LFtier> DraftHandler::initLightForgeTiers(const QString &heroString, const bool multiClassDraft,
+QMap<QString, LFtier> DraftHandler::initLightForgeTiers(const CardClass heroClass, const bool multiClassDraft,
                                                         const bool createCardHist)
 {
-    QMap<QString, LFtier> lightForgeTiers;
+    tierStore.update();
+    QMap<QString, LFtier> lightForgeTiers = tierStore.getLightForgeTiers(heroClass, multiClassDraft);
 
-    QFile jsonFile(Utility::extraPath() + "/lightForge.json");
-    jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(jsonFile.readAll());
-    jsonFile.close();
-    const QJsonArray jsonCardsArray = jsonDoc.object().value("Cards").toArray();
-    for(QJsonValue jsonCard: jsonCardsArray)
+    if(createCardHist)
     {
-        QJsonObject jsonCardObject = jsonCard.toObject();
-        QString code = jsonCardObject.value("CardId").toString();
-
-        const QJsonArray jsonScoresArray = jsonCardObject.value("Scores").toArray();
-        for(QJsonValue jsonScore: jsonScoresArray)
+        for(const QString &code: lightForgeTiers.keys())
         {
-            QJsonObject jsonScoreObject = jsonScore.toObject();
-            QString hero = jsonScoreObject.value("Hero").toString();
-
-            if(multiClassDraft || hero == nullptr || hero == heroString)
-            {
-                LFtier lfTier;
-                lfTier.score = static_cast<int>(jsonScoreObject.value("Score").toDouble());
-
-                if(jsonScoreObject.value("StopAfterFirst").toBool())
-                {
-                    lfTier.maxCard = 1;
-                }
-                else if(jsonScoreObject.value("StopAfterSecond").toBool())
-                {
-                    lfTier.maxCard = 2;
-                }
-                else
-                {
-                    lfTier.maxCard = -1;
-                }
-
-                if(!lightForgeTiers.contains(code))
-                {
-                    if(createCardHist)
-                    {
-                        addCardHist(code, false);
-                        addCardHist(code, true);
-                    }
-
-                    //En multiclass guardaremos el primer score que aparezca
-                    //En cartas neutrales sera el hero == nullptr
-                    //En cartas de clase sera la clase especifica
-                    if(multiClassDraft) lightForgeTiers[code] = lfTier;
-                }
-                //En uniclass guardaremos el ultimo score que aparezca que sera el de la clase del draft
-                if(!multiClassDraft)    lightForgeTiers[code] = lfTier;
-            }
+            addCardHist(code, false);
+            addCardHist(code, true);
         }
     }
 
@@ -370,22 +291,46 @@ void DraftHandler::initCodesAndHistMaps(QString hero)
 {
     cardsDownloading.clear();
     cardsHist.clear();
+    cardsHistMatrixOutdated = true;
 
     if(heroDrafting)
     {
         QTimer::singleShot(1000, this, SLOT(startFindScreenRects()));
 
-        for(const QString &code: heroCodesList)     addCardHist(code, false, true);
+        //Los heroes se precalculan en segundo plano al crear heroCodesList.
+        //Si no han terminado usamos el resultado aqui; histCache se actualiza en finishHeroesHist (finished())
+        if(futureHeroesHist.isRunning())
+        {
+            futureHeroesHist.waitForFinished();
+            const QMap<QString, cv::MatND> hists = futureHeroesHist.result();
+            for(QMap<QString, cv::MatND>::const_iterator it=hists.constBegin(); it!=hists.constEnd(); it++)
+            {
+                if(!heroesHist.contains(it.key()))  heroesHist[it.key()] = it.value();
+            }
+        }
+
+        for(const QString &code: heroCodesList)
+        {
+            if(heroesHist.contains(code))
+            {
+                cardsHist[code] = heroesHist[code];
+                cardsHistMatrixOutdated = true;
+            }
+            else    addCardHist(code, false, true);
+        }
     }
     else //if(drafting) ||Build mechanics window
     {
         startFindScreenRects();
 
-        this->lightForgeTiers = initLightForgeTiers(Utility::classLogNumber2classUL_ULName(hero), this->multiclassArena, drafting);
-        initHearthArenaTiers(Utility::classLogNumber2classUL_ULName(hero), this->multiclassArena);
+        this->lightForgeTiers = initLightForgeTiers(Utility::classLogNumber2classEnum(hero), this->multiclassArena, drafting);
+        initHearthArenaTiers(Utility::classLogNumber2classEnum(hero), this->multiclassArena);
         synergyHandler->initSynergyCodes();
+        synergyHandler->precompileCardData(lightForgeTiers.keys());
     }
 
+    histCache.save();
+
     //Wait for cards
     if(drafting || heroDrafting)
     {
@@ -404,15 +349,27 @@ void DraftHandler::initCodesAndHistMaps(QString hero)
 
 void DraftHandler::reHistDownloadedCardImage(const QString &fileNameCode, bool missingOnWeb)
 {
+    //El png ha sido reemplazado
+    if(!missingOnWeb)
+    {
+        histCache.invalidate(fileNameCode);
+        heroesHist.remove(fileNameCode);
+    }
+
     if(!cardsDownloading.contains(fileNameCode)) return; //No forma parte del drafting
 
-    if(!fileNameCode.isEmpty() && !missingOnWeb)  cardsHist[fileNameCode] = getHist(fileNameCode);
+    if(!fileNameCode.isEmpty() && !missingOnWeb)
+    {
+        cardsHist[fileNameCode] = getHist(fileNameCode);
+        cardsHistMatrixOutdated = true;
+    }
     cardsDownloading.removeOne(fileNameCode);
     emit advanceProgressBar(cardsDownloading.count(), fileNameCode.split("_premium").first() + " downloaded");
     if(cardsDownloading.isEmpty())
     {
         emit showMessageProgressBar("All cards downloaded");
         emit downloadEnded();
+        histCache.save();
         newCaptureDraftLoop();
     }
 }
@@ -472,6 +429,10 @@ void DraftHandler::clearLists(bool keepCounters)
     hearthArenaTiers.clear();
     lightForgeTiers.clear();
     cardsHist.clear();
+    cardsHistMatrixOutdated = true;
+    lookaheadPool.reset();
+    pendingLookaheadTasks.clear();
+    pendingLookaheadCodes.clear();
 
     if(!keepCounters)//endDraft
     {
@@ -490,6 +451,7 @@ void DraftHandler::clearLists(bool keepCounters)
     screenIndex = -1;
     numCaptured = 0;
     extendedCapture = false;
+    clearSlotThumbnails();
 }
 
 
@@ -527,6 +489,7 @@ void DraftHandler::leaveArena()
                 draftCardMaps[i].clear();
                 bestMatchesMaps[i].clear();
             }
+            clearSlotThumbnails();
         }
     }
     else if(heroDrafting)   endHeroDraft();
@@ -667,23 +630,25 @@ void DraftHandler::initSynergyCounters(QList<DeckCard> &deckCardList)
     tdraw = ttoYourHand = tdiscover = 0;
     for(DeckCard &deckCard: deckCardList)
     {
-        if(deckCard.getType() == INVALID_TYPE)  continue;
+        if(deckCard.getType() == INVALID_TYPE || deckCard.total <= 0)  continue;
         QString code = deckCard.getCode();
-        for(int i=0; i<deckCard.total; i++)
+
+        //Todas las copias de la carta en una sola actualizacion
+        int draw, toYourHand, discover;
+        synergyHandler->updateCounters(deckCard, spellList, minionList, weaponList,
+                       drop2List, drop3List, drop4List,
+                       aoeList, tauntList, survivabilityList, drawList,
+                       pingList, damageList, destroyList, reachList,
+                       draw, toYourHand, discover, deckCard.total);
+        tdraw += draw;
+        ttoYourHand += toYourHand;
+        tdiscover += discover;
+
+        deckRatingHA += deckCard.total * hearthArenaTiers.value(code);
+        deckRatingLF += deckCard.total * lightForgeTiers.value(code).score;
+        if(cardsIncludedWinratesMap != nullptr)
         {
-            int draw, toYourHand, discover;
-            synergyHandler->updateCounters(deckCard, spellList, minionList, weaponList,
-                           drop2List, drop3List, drop4List,
-                           aoeList, tauntList, survivabilityList, drawList,
-                           pingList, damageList, destroyList, reachList,
-                           draw, toYourHand, discover);
-            tdraw += draw;
-            ttoYourHand += toYourHand;
-            tdiscover += discover;
-
-            deckRatingHA += hearthArenaTiers[code];
-            deckRatingLF += lightForgeTiers[code].score;
-            deckRatingHSR += (cardsIncludedWinratesMap == nullptr) ? 0 : cardsIncludedWinratesMap[this->arenaHero][code];
+            deckRatingHSR += deckCard.total * cardsIncludedWinratesMap[this->arenaHero].value(code);
         }
     }
 
@@ -868,26 +833,119 @@ void DraftHandler::newCaptureDraftLoop(bool delayed)
 
 
 //Screen Rects detectados
-void DraftHandler::captureDraft()
+bool DraftHandler::stopCaptureDraft()
 {
-    justPickedCard = "";
-
     bool missingTierLists = drafting && (lightForgeTiers.empty() || hearthArenaTiers.empty());
     if((!drafting && !heroDrafting) || missingTierLists ||
         leavingArena || !screenFound() || !cardsDownloading.isEmpty())
     {
         leavingArena = false;
         capturing = false;
-        return;
+        return true;
+    }
+    return false;
+}
+
+
+CaptureSlot DraftHandler::createCaptureSlot(const QImage &capture, const cv::Rect &cardRect, int slot)
+{
+    CaptureSlot captureSlot;
+    captureSlot.capture = capture;
+    captureSlot.cardRect = cardRect;
+    captureSlot.cardsHistMatrix = cardsHistMatrix;
+    captureSlot.cardsMergedMatrix = cardsMergedMatrix;
+    captureSlot.cardsCoarseMatrix = cardsCoarseMatrix;
+    captureSlot.cardsMergedRows = cardsMergedRows;
+    captureSlot.cardsHistBuckets = cardsHistBuckets;
+    for(const QString &code: draftCardMaps[slot].keys())
+    {
+        const int index = cardsHistIndex.value(code, -1);
+        if(index >= 0)  captureSlot.forcedIndexes.append(cardsHistMergedIndex[index]);
     }
+    return captureSlot;
+}
 
-    cv::MatND screenCardsHist[3];
-    if(!getScreenCardsHist(screenCardsHist))
+
+//Captura en el hilo GUI; hist y match de los 3 slots en paralelo en el pool (finishCaptureDraft)
+void DraftHandler::captureDraft()
+{
+    justPickedCard = "";
+
+    if(stopCaptureDraft())  return;
+    if(futureCaptureDraft.isRunning())  return;
+
+    QImage capture;
+    cv::Rect cardRects[3];
+    if(!getScreenCards(capture, cardRects))
     {
         capturing = false;
         return;
     }
-    mapBestMatchingCodes(screenCardsHist);
+
+    if(cardsHistMatrixOutdated) buildCardsHistMatrix();
+
+    //Solo repetimos el match de los slots que han cambiado
+    cv::Mat mat(capture.height(),capture.width(),CV_8UC4,capture.bits(), static_cast<size_t>(capture.bytesPerLine()));
+    bool changedSlots[3];
+    bool sameAsPicked = !pickedThumbnails[0].isEmpty();
+    for(int i=0; i<3; i++)
+    {
+        QByteArray thumbnail = getSlotThumbnail(mat(cardRects[i]));
+        changedSlots[i] = slotMatches[i].isEmpty() || !isSameSlotThumbnail(thumbnail, slotThumbnails[i]);
+        sameAsPicked = sameAsPicked && isSameSlotThumbnail(thumbnail, pickedThumbnails[i]);
+        slotThumbnails[i] = thumbnail;
+    }
+
+    //Aun se ven las cartas del pick anterior, esperamos a que cambie la pantalla
+    if(sameAsPicked)
+    {
+        QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME, this, SLOT(captureDraft()));
+        return;
+    }
+    for(int i=0; i<3; i++)  pickedThumbnails[i].clear();
+
+    QList<CaptureSlot> captureSlots;
+    captureSlotIndexes.clear();
+    for(int i=0; i<3; i++)
+    {
+        if(!changedSlots[i])    continue;
+
+        captureSlots.append(createCaptureSlot(capture, cardRects[i], i));
+        captureSlotIndexes.append(i);
+    }
+
+    if(captureSlots.isEmpty())  processCaptureMatches();
+    else                        futureCaptureDraft.setFuture(QtConcurrent::mapped(captureSlots, &DraftHandler::matchCaptureSlot));
+}
+
+
+void DraftHandler::finishCaptureDraft()
+{
+    if(stopCaptureDraft())  return;
+
+    bool validMatches = futureCaptureDraft.future().resultCount() == captureSlotIndexes.count() && !cardsHistMatrixOutdated;
+    for(int j=0; j<captureSlotIndexes.count() && validMatches; j++)
+    {
+        const int i = captureSlotIndexes[j];
+        slotMatches[i] = futureCaptureDraft.resultAt(j);
+        validMatches = (slotMatches[i].count() == cardsHistCodes.count());
+    }
+
+    //cardsHist ha cambiado durante el match, repetimos la captura
+    if(!validMatches)
+    {
+        for(int i=0; i<3; i++)  slotMatches[i].clear();
+        QTimer::singleShot(CAPTUREDRAFT_LOOP_TIME, this, SLOT(captureDraft()));
+        return;
+    }
+
+    processCaptureMatches();
+}
+
+
+void DraftHandler::processCaptureMatches()
+{
+    mapBestMatchingCodes(slotMatches);
 
     if(areCardsDetected())
     {
@@ -940,7 +998,8 @@ double DraftHandler::getMinMatch(const QMap<QString, DraftCard> &draftCardMaps)
 }
 
 
-void DraftHandler::buildBestMatchesMaps()
+//fillComboBoxes false: sin tocar la UI (benchmarkDraftRecognition)
+void DraftHandler::buildBestMatchesMaps(bool fillComboBoxes)
 {
     if(drafting)
     {
@@ -953,7 +1012,7 @@ void DraftHandler::buildBestMatchesMaps()
                 bestMatchesDups.insertMulti(match, code);
             }
 
-            comboBoxCard[i]->clear();
+            if(fillComboBoxes)  comboBoxCard[i]->clear();
             QStringList insertedCodes;
             for(const QString &code: bestMatchesDups.values())
             {
@@ -961,7 +1020,7 @@ void DraftHandler::buildBestMatchesMaps()
                 {
                     double match = draftCardMaps[i][code].getBestQualityMatches();
                     bestMatchesMaps[i].insertMulti(match, code);
-                    draftCardMaps[i][code].draw(comboBoxCard[i]);
+                    if(fillComboBoxes)  draftCardMaps[i][code].draw(comboBoxCard[i]);
                     insertedCodes.append(degoldCode(code));
                 }
             }
@@ -1015,7 +1074,7 @@ CardRarity DraftHandler::getBestRarity()
 }
 
 
-void DraftHandler::getBestCards(DraftCard bestCards[3])
+void DraftHandler::getBestCards(DraftCard bestCards[3], bool selectComboBoxes)
 {
     CardRarity bestRarity = getBestRarity();
 
@@ -1035,7 +1094,7 @@ void DraftHandler::getBestCards(DraftCard bestCards[3])
                 (bestRarity == LEGENDARY && draftCardMaps[i][code].getRarity() == LEGENDARY))
             {
                 bestCards[i] = draftCardMaps[i][code];
-                comboBoxCard[i]->setCurrentIndex(j);
+                if(selectComboBoxes)    comboBoxCard[i]->setCurrentIndex(j);
                 emit pDebug("Choose: " + cardInfo);
                 break;
             }
@@ -1050,7 +1109,7 @@ void DraftHandler::getBestCards(DraftCard bestCards[3])
         }
     }
 
-    connectAllComboBox();
+    if(selectComboBoxes)    connectAllComboBox();
     emit pDebug("(" + QString::number(synergyHandler->draftedCardsCount()) + ") " +
                 bestCards[0].getCode() + "/" + bestCards[1].getCode() +
                 "/" + bestCards[2].getCode() + " New codes.");
@@ -1111,8 +1170,8 @@ void DraftHandler::pickCard(QString code)
 
         int numCards = synergyHandler->draftedCardsCount();
         lavaButton->setValue(synergyHandler->getManaCounterCount(), numCards, draw, toYourHand, discover);
-        updateDeckScore(hearthArenaTiers[code], lightForgeTiers[code].score,
-                        (cardsIncludedWinratesMap == nullptr) ? 0 : cardsIncludedWinratesMap[this->arenaHero][code]);
+        updateDeckScore(hearthArenaTiers.value(code), lightForgeTiers.value(code).score,
+                        (cardsIncludedWinratesMap == nullptr) ? 0 : cardsIncludedWinratesMap[this->arenaHero].value(code));
         if(draftMechanicsWindow != nullptr)
         {
             draftMechanicsWindow->updateCounters(spellList, minionList, weaponList,
@@ -1142,6 +1201,7 @@ void DraftHandler::pickCard(QString code)
     this->numCaptured = 0;
     this->extendedCapture = false;
     if(draftScoreWindow != nullptr)    draftScoreWindow->hideScores();
+    for(int i=0; i<3; i++)  pickedThumbnails[i] = slotThumbnails[i];
 
     if(!pickHeroPower)
     {
@@ -1179,6 +1239,7 @@ void DraftHandler::refreshCapturedCards()
     this->numCaptured = 0;
     this->extendedCapture = true;
     if(draftScoreWindow != nullptr)    draftScoreWindow->hideScores();
+    clearSlotThumbnails();
 
     newCaptureDraftLoop(false);
 }
@@ -1280,6 +1341,9 @@ void DraftHandler::showNewCards(DraftCard bestCards[3])
                 draftScoreWindow->setSynergies(i, synergies, mechanicIcons, dropBorderColor);
             }
         }
+
+        //Sin consumidor en la UI todavia; el valor esperado solo se escribiria en el log
+//        startLookahead(bestCards);
     }
 }
 
@@ -1405,7 +1469,21 @@ void DraftHandler::showNewRatings(float rating1, float rating2, float rating3,
 }
 
 
-bool DraftHandler::getScreenCardsHist(cv::MatND screenCardsHist[3])
+//Coloca screenRects dentro de capture (que empieza en offset). False si alguno queda fuera.
+bool DraftHandler::fitCardRects(const QImage &capture, const cv::Point &offset, const cv::Rect screenRects[3], cv::Rect cardRects[3])
+{
+    const cv::Rect captureRect(0, 0, capture.width(), capture.height());
+    for(int i=0; i<3; i++)
+    {
+        cardRects[i] = screenRects[i] - offset;
+        if(cardRects[i].area() <= 0 || (cardRects[i] & captureRect) != cardRects[i])  return false;
+    }
+    return true;
+}
+
+
+//Solo capturamos el rectangulo que engloba las 3 cartas, sin copiar la pantalla completa
+bool DraftHandler::getScreenCards(QImage &capture, cv::Rect cardRects[3])
 {
     QList<QScreen *> screens = QGuiApplication::screens();
     if(screenIndex >= screens.count() || screenIndex < 0)  return false;
@@ -1413,28 +1491,194 @@ bool DraftHandler::getScreenCardsHist(cv::MatND screenCardsHist[3])
     if (!screen) return false;
 
     QRect rect = screen->geometry();
-    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
-    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<ulong>(image.bytesPerLine()));
 
-    cv::Mat screenCapture = mat.clone();
+    //screenRects estan en pixeles de la imagen capturada; grabWindow usa coordenadas logicas
+    const qreal dpr = screen->devicePixelRatio();
+    const cv::Rect box = screenRects[0] | screenRects[1] | screenRects[2];
+    const int x = static_cast<int>(std::floor(box.x/dpr));
+    const int y = static_cast<int>(std::floor(box.y/dpr));
+    const int width = static_cast<int>(std::ceil((box.x + box.width)/dpr)) - x;
+    const int height = static_cast<int>(std::ceil((box.y + box.height)/dpr)) - y;
 
-    cv::Mat bigCards[3];
-    bigCards[0] = screenCapture(screenRects[0]);
-    bigCards[1] = screenCapture(screenRects[1]);
-    bigCards[2] = screenCapture(screenRects[2]);
+    capture = screen->grabWindow(0,rect.x()+x,rect.y()+y,width,height).toImage();
+    const cv::Point offset(qRound(x*dpr), qRound(y*dpr));
+    if(!fitCardRects(capture, offset, screenRects, cardRects))
+    {
+        //Escalado inesperado, capturamos la pantalla completa
+        capture = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
+        if(!fitCardRects(capture, cv::Point(0,0), screenRects, cardRects))   return false;
+    }
 
 
 //#ifdef QT_DEBUG
-//    cv::imshow("Card1", bigCards[0]);
-//    cv::imshow("Card2", bigCards[1]);
-//    cv::imshow("Card3", bigCards[2]);
+//    cv::Mat mat(capture.height(),capture.width(),CV_8UC4,capture.bits(), static_cast<ulong>(capture.bytesPerLine()));
+//    cv::imshow("Card1", mat(cardRects[0]));
+//    cv::imshow("Card2", mat(cardRects[1]));
+//    cv::imshow("Card3", mat(cardRects[2]));
 //#endif
 
-    for(int i=0; i<3; i++)  screenCardsHist[i] = getHist(bigCards[i]);
     return true;
 }
 
 
+//Miniatura en gris; robusta al ruido pero detecta el fundido entre picks
+QByteArray DraftHandler::getSlotThumbnail(const cv::Mat &card)
+{
+    cv::Mat small, gray;
+    cv::resize(card, small, SLOT_THUMBNAIL_SIZE, 0, 0, cv::INTER_AREA);
+    cv::cvtColor(small, gray, CV_BGRA2GRAY);
+    if(!gray.isContinuous())    gray = gray.clone();
+    return QByteArray(reinterpret_cast<const char *>(gray.data), static_cast<int>(gray.total()));
+}
+
+
+bool DraftHandler::isSameSlotThumbnail(const QByteArray &thumbnail1, const QByteArray &thumbnail2)
+{
+    if(thumbnail1.isEmpty() || thumbnail1.size() != thumbnail2.size())  return false;
+
+    int diff = 0;
+    for(int i=0; i<thumbnail1.size(); i++)
+    {
+        diff += qAbs(static_cast<uchar>(thumbnail1[i]) - static_cast<uchar>(thumbnail2[i]));
+    }
+    return diff <= SLOT_THUMBNAIL_MAX_DIFF * thumbnail1.size();
+}
+
+
+void DraftHandler::clearSlotThumbnails()
+{
+    for(int i=0; i<3; i++)
+    {
+        slotThumbnails[i].clear();
+        pickedThumbnails[i].clear();
+        slotMatches[i].clear();
+    }
+}
+
+
+//Mejores COARSE_CANDIDATES globales + COARSE_BUCKET_CANDIDATES de cada grupo rareza/clase + forcedIndexes
+QVector<int> DraftHandler::getCoarseCandidates(const CaptureSlot &captureSlot, const cv::MatND &screenHist)
+{
+    const cv::Mat &cardsCoarseMatrix = captureSlot.cardsCoarseMatrix;
+    const int numCards = cardsCoarseMatrix.rows;
+
+    cv::Mat coarseRow = coarseSqrtNormalizedHist(screenHist);
+    cv::Mat coefRow;
+    cv::gemm(coarseRow, cardsCoarseMatrix, 1, cv::Mat(), 0, coefRow, cv::GEMM_2_T);
+    const float *coefs = coefRow.ptr<float>();
+
+    std::vector<char> selected(static_cast<size_t>(numCards), 0);
+    std::vector<int> order;
+    auto selectTop = [&](int begin, int end, int topK)
+    {
+        order.resize(static_cast<size_t>(end - begin));
+        for(int j=begin; j<end; j++)    order[static_cast<size_t>(j-begin)] = j;
+        topK = std::min(topK, end - begin);
+        if(topK <= 0)   return;
+        std::nth_element(order.begin(), order.begin() + (topK-1), order.end(),
+            [coefs](int a, int b){return coefs[a] > coefs[b];});
+        for(int j=0; j<topK; j++)   selected[static_cast<size_t>(order[static_cast<size_t>(j)])] = 1;
+    };
+
+    selectTop(0, numCards, COARSE_CANDIDATES);
+    for(const QPair<int,int> &bucket: captureSlot.cardsHistBuckets)
+    {
+        selectTop(bucket.first, bucket.second, COARSE_BUCKET_CANDIDATES);
+    }
+    for(const int index: captureSlot.forcedIndexes)
+    {
+        if(index >= 0 && index < numCards)  selected[static_cast<size_t>(index)] = 1;
+    }
+
+    QVector<int> candidates;
+    for(int j=0; j<numCards; j++)   if(selected[static_cast<size_t>(j)])    candidates.append(j);
+    return candidates;
+}
+
+
+QVector<double> DraftHandler::matchCaptureSlot(const CaptureSlot &captureSlot)
+{
+    QVector<double> matches;
+    const cv::Mat &cardsHistMatrix = captureSlot.cardsHistMatrix;
+    if(cardsHistMatrix.empty())     return matches;
+
+    //Vista sin copia sobre la captura, compartida por los 3 slots
+    const QImage &capture = captureSlot.capture;
+    cv::Mat mat(capture.height(),capture.width(),CV_8UC4,const_cast<uchar *>(capture.constBits()),
+                static_cast<size_t>(capture.bytesPerLine()));
+    cv::Mat image = mat(captureSlot.cardRect);
+    cv::MatND screenHist = getHist(image);
+    cv::Mat screenRow = sqrtNormalizedHist(screenHist);
+
+    //Pocas cartas (heroes): match completo directamente
+    const cv::Mat &cardsMergedMatrix = captureSlot.cardsMergedMatrix;
+    if(cardsHistMatrix.rows <= COARSE_MIN_CARDS || cardsMergedMatrix.rows != captureSlot.cardsMergedRows.count() ||
+            captureSlot.cardsCoarseMatrix.rows != cardsMergedMatrix.rows)
+    {
+        cv::Mat coefRow;
+        cv::gemm(screenRow, cardsHistMatrix, 1, cv::Mat(), 0, coefRow, cv::GEMM_2_T);
+
+        const float *coefs = coefRow.ptr<float>();
+        matches.resize(cardsHistMatrix.rows);
+        for(int j=0; j<cardsHistMatrix.rows; j++)
+        {
+            matches[j] = std::sqrt(std::max(1.0 - static_cast<double>(coefs[j]), 0.0));
+        }
+        return matches;
+    }
+
+    //Match completo de los candidatos con el hist fusionado normal/golden de cada carta
+    const QVector<int> candidates = getCoarseCandidates(captureSlot, screenHist);
+    std::vector<std::pair<double,int>> mergedMatches;
+    mergedMatches.reserve(static_cast<size_t>(candidates.count()));
+    for(const int j: candidates)
+    {
+        double coef = screenRow.dot(cardsMergedMatrix.row(j));
+        mergedMatches.push_back(std::make_pair(std::sqrt(std::max(1.0 - coef, 0.0)), j));
+    }
+    const int topK = std::min(GOLDEN_RESOLVE_CANDIDATES, static_cast<int>(mergedMatches.size()));
+    std::partial_sort(mergedMatches.begin(), mergedMatches.begin() + topK, mergedMatches.end());
+
+    //Solo los mejores candidatos y los actuales del slot se resuelven en normal/golden.
+    //El match fusionado puede ser mejor que el de ambas variantes, asi que las cartas sin resolver
+    //no pueden quedar por delante de ninguna resuelta: su distancia es al menos la peor resuelta.
+    //Las cartas descartadas quedan con la peor distancia (1)
+    matches.fill(1.0, cardsHistMatrix.rows);
+    double worstResolved = 0;
+    QVector<int> unresolved;
+    for(int k=0; k<static_cast<int>(mergedMatches.size()); k++)
+    {
+        const int j = mergedMatches[static_cast<size_t>(k)].second;
+        const QPair<int,int> &rows = captureSlot.cardsMergedRows[j];
+        const bool resolve = (k < topK) || captureSlot.forcedIndexes.contains(j);
+        if(rows.second - rows.first == 1)
+        {
+            //Una sola variante: el match fusionado es el real
+            matches[rows.first] = mergedMatches[static_cast<size_t>(k)].first;
+            if(resolve) worstResolved = std::max(worstResolved, matches[rows.first]);
+        }
+        else if(resolve)
+        {
+            for(int r=rows.first; r<rows.second; r++)
+            {
+                double coef = screenRow.dot(cardsHistMatrix.row(r));
+                matches[r] = std::sqrt(std::max(1.0 - coef, 0.0));
+                worstResolved = std::max(worstResolved, matches[r]);
+            }
+        }
+        else    unresolved.append(k);
+    }
+
+    for(const int k: unresolved)
+    {
+        const QPair<int,int> &rows = captureSlot.cardsMergedRows[mergedMatches[static_cast<size_t>(k)].second];
+        const double match = std::max(mergedMatches[static_cast<size_t>(k)].first, worstResolved);
+        for(int r=rows.first; r<rows.second; r++)   matches[r] = match;
+    }
+    return matches;
+}
+
+
 bool DraftHandler::isGoldCode(QString fileName)
 {
     return fileName.endsWith("_premium");
@@ -1449,33 +1693,117 @@ QString DraftHandler::degoldCode(QString fileName)
 }
 
 
-void DraftHandler::mapBestMatchingCodes(cv::MatND screenCardsHist[3])
+cv::Mat DraftHandler::sqrtNormalizedHist(const cv::MatND &hist)
+{
+    cv::Mat row = hist.reshape(1, 1);
+    double sum = cv::sum(row)[0];
+    cv::Mat sqrtRow;
+    //Igual que compareHist: un histograma vacio da distancia 1
+    if(sum <= static_cast<double>(FLT_EPSILON)) sqrtRow = cv::Mat::zeros(1, row.cols, CV_32F);
+    else                                        cv::sqrt(row/sum, sqrtRow);
+    return sqrtRow;
+}
+
+
+cv::Mat DraftHandler::coarseSqrtNormalizedHist(const cv::MatND &hist)
+{
+    cv::Mat coarseHist;
+    cv::resize(hist, coarseHist, COARSE_HIST_SIZE, 0, 0, cv::INTER_AREA);
+    return sqrtNormalizedHist(coarseHist);
+}
+
+
+//Las filas se ordenan por rareza/clase para que cada grupo sea un rango continuo,
+//y dentro del grupo code y code_premium quedan juntos bajo su fila fusionada
+void DraftHandler::buildCardsHistMatrix()
+{
+    QMap<int, QMap<QString, QStringList>> bucketCodes;
+    for(const QString &code: cardsHist.keys())
+    {
+        const QString degoldedCode = degoldCode(code);
+        QSharedPointer<const CardInfo> cardInfo = DeckCard::getCardInfo(degoldedCode);
+        bucketCodes[cardInfo->rarity*(NEUTRAL+1) + cardInfo->cardClass][degoldedCode].append(code);
+    }
+
+    cardsHistCodes.clear();
+    cardsHistBuckets.clear();
+    cardsMergedRows.clear();
+    cardsHistMergedIndex.clear();
+    for(const QMap<QString, QStringList> &bucket: bucketCodes)
+    {
+        const int firstMergedRow = cardsMergedRows.count();
+        for(const QStringList &codes: bucket)
+        {
+            cardsMergedRows.append(qMakePair(cardsHistCodes.count(), cardsHistCodes.count() + codes.count()));
+            for(int i=0; i<codes.count(); i++)  cardsHistMergedIndex.append(cardsMergedRows.count() - 1);
+            cardsHistCodes.append(codes);
+        }
+        cardsHistBuckets.append(qMakePair(firstMergedRow, cardsMergedRows.count()));
+    }
+
+    cardsHistIndex.clear();
+    cardsHistMatrix.release();
+    cardsMergedMatrix.release();
+    cardsCoarseMatrix.release();
+    for(int i=0; i<3; i++)  slotMatches[i].clear();
+    cardsHistMatrixOutdated = false;
+    if(cardsHistCodes.isEmpty())    return;
+
+    const cv::MatND &firstHist = cardsHist.first();
+    cardsHistMatrix.create(cardsHistCodes.count(), static_cast<int>(firstHist.total()), CV_32F);
+    cardsMergedMatrix.create(cardsMergedRows.count(), static_cast<int>(firstHist.total()), CV_32F);
+    cardsCoarseMatrix.create(cardsMergedRows.count(), COARSE_HIST_SIZE.area(), CV_32F);
+    for(int j=0; j<cardsMergedRows.count(); j++)
+    {
+        cv::MatND mergedHist = cv::MatND::zeros(firstHist.rows, firstHist.cols, CV_32F);
+        for(int i=cardsMergedRows[j].first; i<cardsMergedRows[j].second; i++)
+        {
+            const QString &code = cardsHistCodes[i];
+            const cv::MatND &hist = cardsHist[code];
+            sqrtNormalizedHist(hist).copyTo(cardsHistMatrix.row(i));
+            cardsHistIndex[code] = i;
+
+            double sum = cv::sum(hist)[0];
+            if(sum > static_cast<double>(FLT_EPSILON))  mergedHist += hist/sum;
+        }
+        sqrtNormalizedHist(mergedHist).copyTo(cardsMergedMatrix.row(j));
+        coarseSqrtNormalizedHist(mergedHist).copyTo(cardsCoarseMatrix.row(j));
+    }
+}
+
+
+void DraftHandler::mapBestMatchingCodes(const QVector<double> matches[3])
 {
     bool newCardsFound = false;
     const int numCandidates = (extendedCapture?CAPTURE_EXTENDED_CANDIDATES:CAPTURE_MIN_CANDIDATES);
+    const int numCards = cardsHistCodes.count();
 
+    std::vector<int> order(static_cast<size_t>(numCards));
     for(int i=0; i<3; i++)
     {
-        QMap<double, QString> bestMatchesMap;
-        for(QMap<QString, cv::MatND>::const_iterator it=cardsHist.constBegin(); it!=cardsHist.constEnd(); it++)
+        //Actualizamos DraftCardMaps con los nuevos resultados
+        if(numCaptured != 0)
         {
-            double match = compareHist(screenCardsHist[i], it.value(), 3);
-            QString code = it.key();
-            bestMatchesMap.insertMulti(match, code);
-
-            //Actualizamos DraftCardMaps con los nuevos resultados
-            if((numCaptured != 0) && draftCardMaps[i].contains(code))
+            for(QMap<QString, DraftCard>::iterator it=draftCardMaps[i].begin(); it!=draftCardMaps[i].end(); it++)
             {
-                draftCardMaps[i][code].setBestQualityMatch(match, false);
+                QHash<QString, int>::const_iterator itIndex = cardsHistIndex.constFind(it.key());
+                if(itIndex != cardsHistIndex.constEnd())
+                {
+                    it.value().setBestQualityMatch(matches[i][itIndex.value()], false);
+                }
             }
         }
 
         //Incluimos en DraftCardMaps los mejores 7 matches, si no han sido ya actualizados por estar en el map.
-        QList<double> bestMatchesList = bestMatchesMap.keys();
-        for(int j=0; j<numCandidates && j<bestMatchesList.count(); j++)
+        for(int j=0; j<numCards; j++)   order[static_cast<size_t>(j)] = j;
+        const int topK = std::min(numCandidates, numCards);
+        const QVector<double> &slotMatches = matches[i];
+        std::partial_sort(order.begin(), order.begin() + topK, order.end(),
+            [&slotMatches](int a, int b){return slotMatches[a] < slotMatches[b];});
+        for(int j=0; j<topK; j++)
         {
-            double match = bestMatchesList.at(j);
-            QString code = bestMatchesMap[match];
+            double match = slotMatches[order[static_cast<size_t>(j)]];
+            const QString &code = cardsHistCodes[order[static_cast<size_t>(j)]];
 
             if(!draftCardMaps[i].contains(code))
             {
@@ -1517,7 +1845,12 @@ void DraftHandler::mapBestMatchingCodes(cv::MatND screenCardsHist[3])
 
 cv::MatND DraftHandler::getHist(const QString &code)
 {
-    cv::Mat fullCard = cv::imread((Utility::hscardsPath() + "/" + code + ".png").toStdString(), CV_LOAD_IMAGE_COLOR);
+    const QString imagePath = Utility::hscardsPath() + "/" + code + ".png";
+    const bool heroCrop = !drafting;
+    cv::MatND hist;
+    if(histCache.get(code, heroCrop, hist))    return hist;
+
+    cv::Mat fullCard = cv::imread(imagePath.toStdString(), CV_LOAD_IMAGE_COLOR);
     cv::Mat srcBase;
     if(drafting)
     {
@@ -1526,40 +1859,20 @@ cv::MatND DraftHandler::getHist(const QString &code)
     }
     else //if(heroDrafting)
     {
-        srcBase = fullCard(cv::Rect(75,201,160,160));
+        srcBase = fullCard(HERO_HIST_RECT);
 //#ifdef QT_DEBUG
 //        cv::imshow(code.toStdString(), srcBase);
 //#endif
     }
-    return getHist(srcBase);
+    hist = getHist(srcBase);
+    histCache.insert(code, heroCrop, imagePath, hist);
+    return hist;
 }
 
 
 cv::MatND DraftHandler::getHist(cv::Mat &srcBase)
 {
-    cv::Mat hsvBase;
-
-    /// Convert to HSV
-    cvtColor( srcBase, hsvBase, cv::COLOR_BGR2HSV );
-
-    /// Using 50 bins for hue and 60 for saturation
-    int h_bins = 50; int s_bins = 60;
-    int histSize[] = { h_bins, s_bins };
-
-    // hue varies from 0 to 179, saturation from 0 to 255
-    float h_ranges[] = { 0, 180 };
-    float s_ranges[] = { 0, 256 };
-    const float* ranges[] = { h_ranges, s_ranges };
-
-    // Use the o-th and 1-st channels
-    int channels[] = { 0, 1 };
-
-    /// Calculate the histograms for the HSV images
-    cv::MatND histBase;
-    calcHist( &hsvBase, 1, channels, cv::Mat(), histBase, 2, histSize, ranges, true, false );
-    normalize( histBase, histBase, 0, 1, cv::NORM_MINMAX, -1, cv::Mat() );
-
-    return histBase;
+    return HsvHist::calcHist(srcBase);
 }
 
 
@@ -1597,7 +1910,15 @@ void DraftHandler::finishFindScreenRects()
 //#endif
         }
 
-        emit pDebug("Hearthstone arena screen detected on screen " + QString::number(screenIndex));
+        if(screenDetection.fromSettings)
+        {
+            emit pDebug("Hearthstone arena screen verified on screen " + QString::number(screenIndex) + " (saved detection)");
+        }
+        else
+        {
+            emit pDebug("Hearthstone arena screen detected on screen " + QString::number(screenIndex));
+            saveScreenDetection(screenDetection);
+        }
 
         createDraftWindows(screenDetection.screenScale);
         if(drafting || heroDrafting)    newCaptureDraftLoop();
@@ -1605,12 +1926,11 @@ void DraftHandler::finishFindScreenRects()
 }
 
 
-ScreenDetection DraftHandler::findScreenRects()
+//Esquinas de las 3 cartas en la plantilla
+std::vector<Point2f> DraftHandler::getTemplatePoints(bool heroTemplate)
 {
-    ScreenDetection screenDetection;
-
     std::vector<Point2f> templatePoints(6);
-    if(heroDrafting)
+    if(heroTemplate)
     {
         templatePoints[0] = cvPoint(182,332); templatePoints[1] = cvPoint(182+152,332+152);
         templatePoints[2] = cvPoint(453,332); templatePoints[3] = cvPoint(453+152,332+152);
@@ -1622,6 +1942,31 @@ ScreenDetection DraftHandler::findScreenRects()
         templatePoints[2] = cvPoint(484,276); templatePoints[3] = cvPoint(484+118,276+118);
         templatePoints[4] = cvPoint(762,276); templatePoints[5] = cvPoint(762+118,276+118);
     }
+    return templatePoints;
+}
+
+
+//Primero probamos la deteccion guardada de cada pantalla (verificacion barata), si no SURF
+ScreenDetection DraftHandler::findScreenRects()
+{
+    ScreenDetection screenDetection;
+
+    std::vector<Point2f> templatePoints = getTemplatePoints(heroDrafting);
+
+    QString arenaTemplate;
+    if(drafting)    arenaTemplate = "arenaTemplate.png";
+    else if(heroDrafting)   arenaTemplate = "heroesTemplate.png";
+    else                    arenaTemplate = "mechanicsTemplate.png";
+
+    //Esquinas de la plantilla
+    QSharedPointer<const TemplateFeatures> features = Utility::getTemplateFeatures(arenaTemplate);
+    if(features.isNull())
+    {
+        screenDetection.screenIndex = -1;
+        return screenDetection;
+    }
+    templatePoints.push_back(Point2f(0, 0));
+    templatePoints.push_back(Point2f(static_cast<float>(features->image.cols), static_cast<float>(features->image.rows)));
 
 
     QList<QScreen *> screens = QGuiApplication::screens();
@@ -1630,10 +1975,22 @@ ScreenDetection DraftHandler::findScreenRects()
         QScreen *screen = screens[screenIndex];
         if (!screen)    continue;
 
-        QString arenaTemplate;
-        if(drafting)    arenaTemplate = "arenaTemplate.png";
-        else if(heroDrafting)   arenaTemplate = "heroesTemplate.png";
-        else                    arenaTemplate = "mechanicsTemplate.png";
+        ScreenDetection savedDetection;
+        if(loadScreenDetection(getScreenDetectionKey(screen, arenaTemplate), savedDetection) &&
+                verifyScreenDetection(screen, savedDetection, arenaTemplate))
+        {
+            savedDetection.screenIndex = screenIndex;
+            savedDetection.fromSettings = true;
+            return savedDetection;
+        }
+    }
+
+
+    for(int screenIndex=0; screenIndex<screens.count(); screenIndex++)
+    {
+        QScreen *screen = screens[screenIndex];
+        if (!screen)    continue;
+
         std::vector<Point2f> screenPoints = Utility::findTemplateOnScreen(arenaTemplate, screen,
                                                                           templatePoints, screenDetection.screenScale);
         if(screenPoints.empty())    continue;
@@ -1643,8 +2000,10 @@ ScreenDetection DraftHandler::findScreenRects()
         {
             screenDetection.screenRects[i]=cv::Rect(screenPoints[static_cast<ulong>(i*2)], screenPoints[static_cast<ulong>(i*2+1)]);
         }
+        screenDetection.templateRect = cv::Rect(screenPoints[6], screenPoints[7]);
 
         screenDetection.screenIndex = screenIndex;
+        screenDetection.settingsKey = getScreenDetectionKey(screen, arenaTemplate);
         return screenDetection;
     }
 
@@ -1653,6 +2012,94 @@ ScreenDetection DraftHandler::findScreenRects()
 }
 
 
+//Pantalla (nombre y resolucion) + plantilla
+QString DraftHandler::getScreenDetectionKey(QScreen *screen, const QString &arenaTemplate)
+{
+    QRect rect = screen->geometry();
+    QString screenId = screen->name() + "_" + QString::number(rect.width()) + "x" + QString::number(rect.height()) +
+            "_" + QString::number(screen->devicePixelRatio());
+    screenId.replace(QRegularExpression("[/\\\\]"), "_");
+    return "screenDetection/" + arenaTemplate.split(".").first() + "/" + screenId;
+}
+
+
+static QVariantList rect2Variant(const cv::Rect &rect)
+{
+    return QVariantList() << rect.x << rect.y << rect.width << rect.height;
+}
+
+
+static cv::Rect variant2Rect(const QVariant &variant)
+{
+    QVariantList list = variant.toList();
+    if(list.count() != 4)   return cv::Rect();
+    return cv::Rect(list[0].toInt(), list[1].toInt(), list[2].toInt(), list[3].toInt());
+}
+
+
+bool DraftHandler::loadScreenDetection(const QString &settingsKey, ScreenDetection &screenDetection)
+{
+    QSettings settings("Arena Tracker", "Arena Tracker");
+    if(!settings.contains(settingsKey + "/templateRect"))   return false;
+
+    for(int i=0; i<3; i++)
+    {
+        screenDetection.screenRects[i] = variant2Rect(settings.value(settingsKey + "/rect" + QString::number(i)));
+        if(screenDetection.screenRects[i].area() <= 0)  return false;
+    }
+    screenDetection.templateRect = variant2Rect(settings.value(settingsKey + "/templateRect"));
+    screenDetection.screenScale = settings.value(settingsKey + "/screenScale").toPointF();
+    screenDetection.settingsKey = settingsKey;
+    return screenDetection.templateRect.area() > 0 && !screenDetection.screenScale.isNull();
+}
+
+
+void DraftHandler::saveScreenDetection(const ScreenDetection &screenDetection)
+{
+    if(screenDetection.settingsKey.isEmpty() || screenDetection.templateRect.area() <= 0)  return;
+
+    QSettings settings("Arena Tracker", "Arena Tracker");
+    const QString &settingsKey = screenDetection.settingsKey;
+    for(int i=0; i<3; i++)
+    {
+        settings.setValue(settingsKey + "/rect" + QString::number(i), rect2Variant(screenDetection.screenRects[i]));
+    }
+    settings.setValue(settingsKey + "/templateRect", rect2Variant(screenDetection.templateRect));
+    settings.setValue(settingsKey + "/screenScale", screenDetection.screenScale);
+}
+
+
+//Correlacion de la zona de la plantilla en pantalla con la plantilla. No usamos las gemas de rareza
+//porque cambian de color en cada pick.
+bool DraftHandler::verifyScreenDetection(QScreen *screen, const ScreenDetection &screenDetection, const QString &arenaTemplate)
+{
+    QSharedPointer<const TemplateFeatures> features = Utility::getTemplateFeatures(arenaTemplate);
+    if(features.isNull())   return false;
+
+    const QRect rect = screen->geometry();
+    const QPointF &scale = screenDetection.screenScale;
+    const cv::Rect &templateRect = screenDetection.templateRect;
+    const int x = static_cast<int>(templateRect.x * scale.x());
+    const int y = static_cast<int>(templateRect.y * scale.y());
+    const int width = static_cast<int>(templateRect.width * scale.x());
+    const int height = static_cast<int>(templateRect.height * scale.y());
+    if(x < 0 || y < 0 || width <= 0 || height <= 0 || x + width > rect.width() || y + height > rect.height())    return false;
+
+    QImage image = screen->grabWindow(0,rect.x()+x,rect.y()+y,width,height).toImage();
+    if(image.isNull())  return false;
+    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<size_t>(image.bytesPerLine()));
+
+    cv::Mat gray, grayResized, result;
+    cv::cvtColor(mat, gray, CV_BGRA2GRAY);
+    cv::resize(gray, grayResized, features->image.size(), 0, 0, cv::INTER_AREA);
+    cv::matchTemplate(grayResized, features->image, result, CV_TM_CCOEFF_NORMED);
+    const double score = static_cast<double>(result.at<float>(0,0));
+
+    qDebug()<<"DraftHandler: Saved screen detection" << screenDetection.settingsKey << "score:" << score;
+    return score > SCREEN_VERIFY_THRESHOLD;
+}
+
+
 void DraftHandler::beginHeroDraft()
 {
     emit pDebug("Begin hero draft.");
@@ -1976,6 +2423,7 @@ void DraftHandler::setShowDrops(bool value)
 void DraftHandler::setDraftMethodAvgScore(DraftMethod draftMethodAvgScore)
 {
     this->draftMethodAvgScore = draftMethodAvgScore;
+    lookaheadPool.reset();//Scores del pool
 
     if(!isDrafting())   return;
     if(draftMechanicsWindow != nullptr)    draftMechanicsWindow->setDraftMethodAvgScore(draftMethodAvgScore);
@@ -2164,6 +2612,13 @@ void DraftHandler::setCardsIncludedWinratesMap(QMap<QString, float> cardsInclude
 }
 
 
+void DraftHandler::setCardsPickratesMap(QMap<QString, float> cardsPickratesMap[])
+{
+    this->cardsPickratesMap = cardsPickratesMap;
+    lookaheadPool.reset();
+}
+
+
 void DraftHandler::setCardsIncludedDecksMap(QMap<QString, int> cardsIncludedDecksMap[])
 {
     this->cardsIncludedDecksMap = cardsIncludedDecksMap;
@@ -2192,6 +2647,61 @@ void DraftHandler::buildHeroCodesList()
         if(code.startsWith("HERO_0") || code.startsWith("HERO_1"))   heroCodesList.append(code);
     }
 //    qDebug()<<endl<<"HERO CODES!!!!!!!!!!!!!!!!!!!!!!!!"<<endl<<heroCodesList<<endl;
+
+    startHeroesHist();
+}
+
+
+//Los hist de heroes en histCache se usan directamente, el resto se calcula en un hilo
+void DraftHandler::startHeroesHist()
+{
+    if(futureHeroesHist.isRunning())    return;
+
+    heroesHist.clear();
+    QStringList missingCodes;
+    for(const QString &code: heroCodesList)
+    {
+        if(!Utility::cardImageExists(code)) continue;
+
+        cv::MatND hist;
+        if(histCache.get(code, true, hist)) heroesHist[code] = hist;
+        else                                missingCodes.append(code);
+    }
+
+    emit pDebug("Heroes hist: " + QString::number(heroesHist.count()) + " cached, " +
+                QString::number(missingCodes.count()) + " to compute.");
+    if(!missingCodes.isEmpty())
+    {
+        futureHeroesHist.setFuture(QtConcurrent::run(&DraftHandler::computeHeroesHist, missingCodes));
+    }
+}
+
+
+QMap<QString, cv::MatND> DraftHandler::computeHeroesHist(const QStringList &codes)
+{
+    QMap<QString, cv::MatND> hists;
+    for(const QString &code: codes)
+    {
+        cv::Mat fullCard = cv::imread((Utility::hscardsPath() + "/" + code + ".png").toStdString(), CV_LOAD_IMAGE_COLOR);
+        const cv::Rect heroRect = HERO_HIST_RECT;
+        if((heroRect & cv::Rect(0, 0, fullCard.cols, fullCard.rows)) != heroRect)   continue;
+
+        cv::Mat srcBase = fullCard(heroRect);
+        hists[code] = getHist(srcBase);
+    }
+    return hists;
+}
+
+
+void DraftHandler::finishHeroesHist()
+{
+    const QMap<QString, cv::MatND> hists = futureHeroesHist.result();
+    for(QMap<QString, cv::MatND>::const_iterator it=hists.constBegin(); it!=hists.constEnd(); it++)
+    {
+        if(!heroesHist.contains(it.key()))  heroesHist[it.key()] = it.value();
+        histCache.insert(it.key(), true, Utility::hscardsPath() + "/" + it.key() + ".png", it.value());
+    }
+    histCache.save();
 }
 
 
@@ -2216,3 +2726,309 @@ void DraftHandler::buildHeroCodesList()
 //07) Warlock
 //08) Mage
 //09) Priest
+
+
+//Benchmark offline del reconocimiento de cartas con screenshots de drafts.
+//dirPath/groundTruth.txt, una linea por screenshot: <fichero.png> <heroLogNumber> <code1> <code2> <code3>
+void DraftHandler::swapMatchState(DraftMatchState &state)
+{
+    std::swap(cardsHist, state.cardsHist);
+    std::swap(cardsHistMatrix, state.cardsHistMatrix);
+    std::swap(cardsMergedMatrix, state.cardsMergedMatrix);
+    std::swap(cardsCoarseMatrix, state.cardsCoarseMatrix);
+    std::swap(cardsMergedRows, state.cardsMergedRows);
+    std::swap(cardsHistBuckets, state.cardsHistBuckets);
+    std::swap(cardsHistMergedIndex, state.cardsHistMergedIndex);
+    std::swap(cardsHistCodes, state.cardsHistCodes);
+    std::swap(cardsHistIndex, state.cardsHistIndex);
+    std::swap(cardsHistMatrixOutdated, state.cardsHistMatrixOutdated);
+    for(int i=0; i<3; i++)
+    {
+        std::swap(slotMatches[i], state.slotMatches[i]);
+        std::swap(draftCardMaps[i], state.draftCardMaps[i]);
+        std::swap(bestMatchesMaps[i], state.bestMatchesMaps[i]);
+        std::swap(cardDetected[i], state.cardDetected[i]);
+    }
+    std::swap(numCaptured, state.numCaptured);
+    std::swap(extendedCapture, state.extendedCapture);
+    std::swap(drafting, state.drafting);
+}
+
+
+//Trabaja con su propio DraftMatchState: no cambia las tier lists, los counters, la UI ni el estado del draft
+//y no descarga imagenes (las cartas sin png no entran en el benchmark).
+void DraftHandler::benchmarkDraftRecognition(const QString &dirPath)
+{
+    if(isDrafting() || heroDrafting || futureCaptureDraft.isRunning())
+    {
+        emit pDebug("Benchmark: Cannot run while drafting.", DebugLevel::Warning);
+        return;
+    }
+
+    QFile truthFile(dirPath + "/groundTruth.txt");
+    if(!truthFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        emit pDebug("Benchmark: Cannot open " + truthFile.fileName(), DebugLevel::Error);
+        return;
+    }
+    const QStringList lines = QString::fromUtf8(truthFile.readAll()).split('\n', QString::SkipEmptyParts);
+    truthFile.close();
+
+    const std::vector<Point2f> templatePoints = getTemplatePoints(false);
+    QString currentHero;
+    int numScreens = 0, numFound = 0, numDetected = 0, numCards = 0, numCorrect = 0, totalIterations = 0;
+    qint64 totalMatchTime = 0, maxMatchTime = 0;
+    int numMatchIterations = 0;
+
+    DraftMatchState savedState;
+    savedState.drafting = true;//getHist usa el recorte de carta
+    swapMatchState(savedState);
+    tierStore.update();
+
+    for(const QString &line: lines)
+    {
+        QStringList fields = line.simplified().split(' ');
+        if(fields.count() != 5 || fields[0].startsWith('#'))    continue;
+        numScreens++;
+
+        //Hists del heroe del screenshot
+        if(fields[1] != currentHero)
+        {
+            currentHero = fields[1];
+            cardsHist.clear();
+            cardsHistMatrixOutdated = true;
+            const QStringList codes = tierStore.getLightForgeTiers(Utility::classLogNumber2classEnum(currentHero), multiclassArena).keys();
+            for(const QString &code: codes)
+            {
+                addCardHist(code, false, false, false);
+                addCardHist(code, true, false, false);
+            }
+            histCache.save();
+            emit pDebug("Benchmark: Hero " + currentHero + " - " + QString::number(cardsHist.count()) + " card hists.");
+        }
+
+        QImage capture = QImage(dirPath + "/" + fields[0]).convertToFormat(QImage::Format_RGB32);
+        if(capture.isNull())
+        {
+            emit pDebug("Benchmark: Cannot open " + fields[0], DebugLevel::Warning);
+            continue;
+        }
+
+        cv::Mat mat(capture.height(),capture.width(),CV_8UC4,capture.bits(), static_cast<size_t>(capture.bytesPerLine()));
+        std::vector<Point2f> screenPoints = Utility::findTemplateOnImage("arenaTemplate.png", mat, templatePoints);
+        cv::Rect screenCardRects[3], cardRects[3];
+        if(screenPoints.size() >= 6)
+        {
+            for(int i=0; i<3; i++)
+            {
+                screenCardRects[i] = cv::Rect(screenPoints[static_cast<ulong>(i*2)], screenPoints[static_cast<ulong>(i*2+1)]);
+            }
+        }
+        if(screenPoints.size() < 6 || !fitCardRects(capture, cv::Point(0,0), screenCardRects, cardRects))
+        {
+            emit pDebug("Benchmark: " + fields[0] + " arena screen not found.", DebugLevel::Warning);
+            continue;
+        }
+        numFound++;
+
+        //Misma imagen en cada iteracion, como una pantalla estatica
+        for(int i=0; i<3; i++)
+        {
+            cardDetected[i] = false;
+            draftCardMaps[i].clear();
+            bestMatchesMaps[i].clear();
+            slotMatches[i].clear();
+        }
+        numCaptured = 0;
+        extendedCapture = false;
+        if(cardsHistMatrixOutdated) buildCardsHistMatrix();
+
+        int iterations = 0;
+        bool detected = false;
+        while(!detected && iterations < BENCHMARK_MAX_ITERATIONS)
+        {
+            QElapsedTimer timer;
+            timer.start();
+
+            QList<CaptureSlot> captureSlots;
+            for(int i=0; i<3; i++)  captureSlots.append(createCaptureSlot(capture, cardRects[i], i));
+            QList<QVector<double>> results = QtConcurrent::blockingMapped(captureSlots, &DraftHandler::matchCaptureSlot);
+            for(int i=0; i<3; i++)  slotMatches[i] = results[i];
+            mapBestMatchingCodes(slotMatches);
+
+            qint64 matchTime = timer.nsecsElapsed();
+            totalMatchTime += matchTime;
+            maxMatchTime = std::max(maxMatchTime, matchTime);
+            numMatchIterations++;
+            iterations++;
+            detected = areCardsDetected();
+        }
+
+        numCards += 3;
+        if(!detected)
+        {
+            emit pDebug("Benchmark: " + fields[0] + " cards not detected after " + QString::number(iterations) + " iterations.",
+                        DebugLevel::Warning);
+            continue;
+        }
+        numDetected++;
+        totalIterations += iterations;
+
+        buildBestMatchesMaps(false);
+        DraftCard bestCards[3];
+        getBestCards(bestCards, false);
+
+        QString result;
+        for(int i=0; i<3; i++)
+        {
+            const QString &truthCode = fields[2+i];
+            bool correct = (bestCards[i].getCode() == truthCode);
+            if(correct) numCorrect++;
+            const double truthMatch = draftCardMaps[i].contains(truthCode)?
+                        draftCardMaps[i][truthCode].getBestQualityMatches():-1;
+            result += " [" + bestCards[i].getCode() + (correct?" OK":(" FAIL " + truthCode + " match " +
+                      QString::number(truthMatch, 'f', 3))) + "]";
+        }
+        emit pDebug("Benchmark: " + fields[0] + " iterations " + QString::number(iterations) + result);
+    }
+    swapMatchState(savedState);
+
+    emit pDebug("Benchmark: Screens " + QString::number(numScreens) + " - Found " + QString::number(numFound) +
+                " - Detected " + QString::number(numDetected));
+    emit pDebug("Benchmark: Accuracy " + QString::number(numCorrect) + "/" + QString::number(numCards) +
+                (numCards>0?(" (" + QString::number(100.0*numCorrect/numCards, 'f', 1) + "%)"):""));
+    if(numDetected > 0)
+    {
+        emit pDebug("Benchmark: Avg iterations until detected " +
+                    QString::number(static_cast<double>(totalIterations)/numDetected, 'f', 2));
+    }
+    if(numMatchIterations > 0)
+    {
+        emit pDebug("Benchmark: Match iteration latency avg " +
+                    QString::number(totalMatchTime/1000000.0/numMatchIterations, 'f', 2) + " ms - max " +
+                    QString::number(maxMatchTime/1000000.0, 'f', 2) + " ms");
+    }
+}
+
+
+//Score de una carta con el metodo de la media del mazo
+float DraftHandler::getLookaheadScore(const QString &code)
+{
+    switch(draftMethodAvgScore)
+    {
+        case HearthArena:
+            return hearthArenaTiers.value(code);
+        case HSReplay:
+            return (cardsIncludedWinratesMap == nullptr) ? 0 : cardsIncludedWinratesMap[this->arenaHero].value(code);
+        default:
+            return lightForgeTiers.value(code).score;
+    }
+}
+
+
+float DraftHandler::getDeckRatingSum()
+{
+    switch(draftMethodAvgScore)
+    {
+        case HearthArena:
+            return deckRatingHA;
+        case HSReplay:
+            return deckRatingHSR;
+        default:
+            return deckRatingLF;
+    }
+}
+
+
+//Cartas de arena de la clase (lightForgeTiers) con su aportacion a los contadores y su pickrate.
+//Se crea una vez por draft, los CardCounterData quedan cacheados en synergyHandler.
+void DraftHandler::buildLookaheadPool()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const bool validHero = (this->arenaHero < NUM_HEROS);
+    QVector<LookaheadCard> *pool = new QVector<LookaheadCard>();
+    pool->reserve(lightForgeTiers.count());
+    for(const QString &code: lightForgeTiers.keys())
+    {
+        DeckCard deckCard(code);
+        if(deckCard.getType() == INVALID_TYPE || deckCard.getType() == HERO_POWER)    continue;
+
+        float pickrate = (cardsPickratesMap == nullptr || !validHero) ? 0 : cardsPickratesMap[this->arenaHero].value(code);
+        pool->append(DraftLookahead::makeCard(synergyHandler->getCardCounterData(deckCard), getLookaheadScore(code), pickrate));
+    }
+    lookaheadPool = QSharedPointer<const QVector<LookaheadCard>>(pool);
+    lookaheadScoreScale = DraftLookahead::getScoreScale(*pool);
+
+    emit pDebug("Lookahead: Pool of " + QString::number(pool->count()) + " cards built in " +
+                QString::number(timer.elapsed()) + " ms. Score scale: " +
+                QString::number(static_cast<double>(lookaheadScoreScale), 'f', 1));
+}
+
+
+//Valor esperado del mazo final para cada uno de los 3 candidatos, en el pool de hilos.
+//Si la evaluacion anterior no ha terminado guardamos esta oferta (solo la ultima) y se lanza en finishLookahead.
+void DraftHandler::startLookahead(DraftCard bestCards[3])
+{
+    if(synergyHandler == nullptr)   return;
+    if(lookaheadPool.isNull())  buildLookaheadPool();
+
+    const bool validHero = (this->arenaHero < NUM_HEROS);
+    const LookaheadDeck deck = DraftLookahead::makeDeck(synergyHandler->getDeckState(), getDeckRatingSum(), lookaheadScoreScale);
+    QList<LookaheadTask> tasks;
+    QStringList codes;
+    for(int i=0; i<3; i++)
+    {
+        const QString code = bestCards[i].getCode();
+        if(code.isEmpty())  return;
+
+        float pickrate = (cardsPickratesMap == nullptr || !validHero) ? 0 : cardsPickratesMap[this->arenaHero].value(code);
+        LookaheadTask task;
+        task.deck = deck;
+        task.pool = lookaheadPool;
+        task.seed = static_cast<quint32>(deck.numCards + 1);
+        task.candidate = DraftLookahead::makeCard(synergyHandler->getCardCounterData(bestCards[i]), getLookaheadScore(code), pickrate);
+        tasks.append(task);
+        codes.append(code);
+    }
+
+    if(futureLookahead.isRunning())
+    {
+        pendingLookaheadTasks = tasks;
+        pendingLookaheadCodes = codes;
+        return;
+    }
+    launchLookahead(tasks, codes);
+}
+
+
+void DraftHandler::launchLookahead(const QList<LookaheadTask> &tasks, const QStringList &codes)
+{
+    lookaheadCodes = codes;
+    futureLookahead.setFuture(QtConcurrent::mapped(tasks, &DraftLookahead::evaluate));
+}
+
+
+void DraftHandler::finishLookahead()
+{
+    QFuture<float> future = futureLookahead.future();
+    if(drafting && future.resultCount() == lookaheadCodes.count())
+    {
+        QString values;
+        for(int i=0; i<lookaheadCodes.count(); i++)
+        {
+            values += " [" + lookaheadCodes[i] + " " + QString::number(static_cast<double>(future.resultAt(i)), 'f', 1) + "]";
+        }
+        emit pDebug("Lookahead: Expected deck value" + values);
+    }
+
+    if(!pendingLookaheadTasks.isEmpty())
+    {
+        const QList<LookaheadTask> tasks = pendingLookaheadTasks;
+        const QStringList codes = pendingLookaheadCodes;
+        pendingLookaheadTasks.clear();
+        pendingLookaheadCodes.clear();
+        if(drafting)    launchLookahead(tasks, codes);
+    }
+}
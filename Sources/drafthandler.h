@@ -11,6 +11,10 @@
 #include "synergyhandler.h"
 #include "twitchhandler.h"
 #include "arenahandler.h"
+#include "Utils/histcache.h"
+#include "Utils/tierstore.h"
+#include "Utils/hsvhist.h"
+#include "Synergies/draftlookahead.h"
 #include <QObject>
 #include <QFutureWatcher>
 
@@ -20,18 +24,26 @@
 #define CAPTUREDRAFT_LOOP_TIME_FADING   200
 #define CAPTUREDRAFT_LOOP_FLANN_TIME    200
 
+#define SCREEN_VERIFY_THRESHOLD         0.6
+
+#define BENCHMARK_MAX_ITERATIONS        30
+
 #define CARD_ACCEPTED_THRESHOLD             0.35
 #define CARD_ACCEPTED_THRESHOLD_INCREASE    0.02
 #define CAPTURE_MIN_CANDIDATES                 7
 #define CAPTURE_EXTENDED_CANDIDATES            15
 
+#define HERO_HIST_RECT                  cv::Rect(75,201,160,160)
+
+#define SLOT_THUMBNAIL_SIZE             cv::Size(8,8)
+#define SLOT_THUMBNAIL_MAX_DIFF         4
+
+#define COARSE_HIST_SIZE                cv::Size(12,10)
+#define COARSE_MIN_CARDS                400
+#define COARSE_CANDIDATES               200
+#define COARSE_BUCKET_CANDIDATES        20
+#define GOLDEN_RESOLVE_CANDIDATES       20
 
-class LFtier
-{
-public:
-    int score = 0;
-    int maxCard = -1;
-};
 
 class ScreenDetection
 {
@@ -39,6 +51,44 @@ public:
     cv::Rect screenRects[3];
     int screenIndex = -1;
     QPointF screenScale = QPointF(0,0);
+    cv::Rect templateRect;//Plantilla en la pantalla, para verificar la deteccion guardada
+    QString settingsKey;
+    bool fromSettings = false;
+};
+
+//Un slot de la captura que se procesa (hist + match) en un hilo del pool
+class CaptureSlot
+{
+public:
+    QImage capture;
+    cv::Rect cardRect;
+    cv::Mat cardsHistMatrix;
+    cv::Mat cardsMergedMatrix;
+    cv::Mat cardsCoarseMatrix;
+    QVector<QPair<int,int>> cardsMergedRows;
+    QVector<QPair<int,int>> cardsHistBuckets;
+    QVector<int> forcedIndexes;//Candidatos actuales del slot (filas fusionadas), siempre se refinan
+};
+
+//Estado del reconocimiento de cartas. benchmarkDraftRecognition lo intercambia (swapMatchState)
+//para trabajar con sus propias matrices sin tocar las del draft.
+class DraftMatchState
+{
+public:
+    QMap<QString, cv::MatND> cardsHist;
+    cv::Mat cardsHistMatrix, cardsMergedMatrix, cardsCoarseMatrix;
+    QVector<QPair<int,int>> cardsMergedRows, cardsHistBuckets;
+    QVector<int> cardsHistMergedIndex;
+    QStringList cardsHistCodes;
+    QHash<QString, int> cardsHistIndex;
+    bool cardsHistMatrixOutdated = true;
+    QVector<double> slotMatches[3];
+    QMap<QString, DraftCard> draftCardMaps[3];
+    QMap<double, QString> bestMatchesMaps[3];
+    bool cardDetected[3] = {false, false, false};
+    int numCaptured = 0;
+    bool extendedCapture = false;
+    bool drafting = false;
 };
 
 class DraftHandler : public QObject
@@ -59,7 +109,27 @@ private:
     ScoreButton *scoreButtonLF, *scoreButtonHA, *scoreButtonHSR;
     QMap<QString, int> hearthArenaTiers;
     QMap<QString, LFtier> lightForgeTiers;
+    TierStore tierStore;
     QMap<QString, cv::MatND> cardsHist;
+    HistCache histCache;
+    //Fila i: sqrt(hist/sum(hist)) de cardsHistCodes[i]. Bhattacharyya se reduce a un producto escalar.
+    cv::Mat cardsHistMatrix;
+    //Una fila por carta con el hist fusionado normal/golden (media de los hist normalizados)
+    cv::Mat cardsMergedMatrix;
+    //Igual con el hist fusionado reducido a COARSE_HIST_SIZE, para descartar candidatos antes del match completo
+    cv::Mat cardsCoarseMatrix;
+    //Fila fusionada j --> filas [first, second) de cardsHistMatrix (code y code_premium)
+    QVector<QPair<int,int>> cardsMergedRows;
+    QVector<int> cardsHistMergedIndex;//Fila de cardsHistMatrix --> fila fusionada
+    //Filas fusionadas [first, second) de cada grupo rareza/clase
+    QVector<QPair<int,int>> cardsHistBuckets;
+    QStringList cardsHistCodes;
+    QHash<QString, int> cardsHistIndex;
+    bool cardsHistMatrixOutdated;
+    //Miniatura 8x8 de cada slot en la ultima captura y en el ultimo pick; si no cambian no repetimos el match
+    QByteArray slotThumbnails[3], pickedThumbnails[3];
+    QVector<double> slotMatches[3];
+    QList<int> captureSlotIndexes;
     QStringList cardsDownloading;
     DraftCard draftCards[3];
     //Guarda los mejores candidatos de esta iteracion
@@ -85,6 +155,7 @@ private:
     bool draftMethodHA, draftMethodLF, draftMethodHSR;
     DraftMethod draftMethodAvgScore;
     QFutureWatcher<ScreenDetection> futureFindScreenRects;
+    QFutureWatcher<QVector<double>> futureCaptureDraft;
     QLabel *labelLFscore[3];
     QLabel *labelHAscore[3];
     QLabel *labelHSRscore[3];
@@ -92,10 +163,21 @@ private:
     bool extendedCapture;
     bool normalizedLF;
     QStringList heroCodesList;
+    QMap<QString, cv::MatND> heroesHist;//Precalculados tras buildHeroCodesList
+    QFutureWatcher<QMap<QString, cv::MatND>> futureHeroesHist;
     QMap<QString, float> heroWinratesMap;
     QMap<QString, float> *cardsIncludedWinratesMap;
     QMap<QString, int> *cardsIncludedDecksMap;
     QMap<QString, float> *cardsPlayedWinratesMap;
+    QMap<QString, float> *cardsPickratesMap;
+    //Pool de arena para la simulacion what-if, se crea en el primer uso del draft
+    QSharedPointer<const QVector<LookaheadCard>> lookaheadPool;
+    float lookaheadScoreScale;//Desviacion tipica del score del pool con el metodo actual
+    QFutureWatcher<float> futureLookahead;
+    QStringList lookaheadCodes;
+    //Ultima oferta recibida mientras se evaluaba la anterior, se lanza al terminar
+    QList<LookaheadTask> pendingLookaheadTasks;
+    QStringList pendingLookaheadCodes;
     TwitchHandler *twitchHandler;
     bool multiclassArena;
 
@@ -104,16 +186,29 @@ private:
 private:
     void completeUI();
     cv::MatND getHist(const QString &code);
-    cv::MatND getHist(cv::Mat &srcBase);
+    static cv::MatND getHist(cv::Mat &srcBase);
     void initCodesAndHistMaps(QString hero="");
     void resetTab(bool alreadyDrafting);
     void clearLists(bool keepCounters);
     void endDraft();
-    bool getScreenCardsHist(cv::MatND screenCardsHist[3]);
+    bool getScreenCards(QImage &capture, cv::Rect cardRects[3]);
+    static bool fitCardRects(const QImage &capture, const cv::Point &offset, const cv::Rect screenRects[3], cv::Rect cardRects[3]);
+    static QVector<double> matchCaptureSlot(const CaptureSlot &captureSlot);
+    CaptureSlot createCaptureSlot(const QImage &capture, const cv::Rect &cardRect, int slot);
+    static std::vector<Point2f> getTemplatePoints(bool heroTemplate);
+    bool stopCaptureDraft();
+    void processCaptureMatches();
+    void clearSlotThumbnails();
+    static QByteArray getSlotThumbnail(const cv::Mat &card);
+    static bool isSameSlotThumbnail(const QByteArray &thumbnail1, const QByteArray &thumbnail2);
     void showNewCards(DraftCard bestCards[]);
     void updateDeckScore(float cardRatingHA=0, float cardRatingLF=0, float cardRatingHSR=0);
     bool screenFound();
     ScreenDetection findScreenRects();
+    static QString getScreenDetectionKey(QScreen *screen, const QString &arenaTemplate);
+    static bool loadScreenDetection(const QString &settingsKey, ScreenDetection &screenDetection);
+    static void saveScreenDetection(const ScreenDetection &screenDetection);
+    static bool verifyScreenDetection(QScreen *screen, const ScreenDetection &screenDetection, const QString &arenaTemplate);
     void clearScore(QLabel *label, DraftMethod draftMethod, bool clearText=true);
     void highlightScore(QLabel *label, DraftMethod draftMethod);
     void deleteDraftHeroWindow();
@@ -121,16 +216,21 @@ private:
     void showOverlay();
     void newCaptureDraftLoop(bool delayed=false);
     void updateScoresVisibility();
-    void initHearthArenaTiers(const QString &heroString, const bool multiClassDraft);
-    QMap<QString, LFtier> initLightForgeTiers(const QString &heroString, const bool multiClassDraft, const bool createCardHist);
+    void initHearthArenaTiers(const CardClass heroClass, const bool multiClassDraft);
+    QMap<QString, LFtier> initLightForgeTiers(const CardClass heroClass, const bool multiClassDraft, const bool createCardHist);
     void createDraftWindows(const QPointF &screenScale);
-    void mapBestMatchingCodes(cv::MatND screenCardsHist[]);
+    void mapBestMatchingCodes(const QVector<double> matches[3]);
+    void buildCardsHistMatrix();
+    static cv::Mat sqrtNormalizedHist(const cv::MatND &hist);
+    static cv::Mat coarseSqrtNormalizedHist(const cv::MatND &hist);
+    static QVector<int> getCoarseCandidates(const CaptureSlot &captureSlot, const cv::MatND &screenHist);
     double getMinMatch(const QMap<QString, DraftCard> &draftCardMaps);
     bool areCardsDetected();
-    void buildBestMatchesMaps();
+    void buildBestMatchesMaps(bool fillComboBoxes=true);
     CardRarity getBestRarity();
-    void getBestCards(DraftCard bestCards[3]);
-    void addCardHist(QString code, bool premium, bool isHero=false);
+    void getBestCards(DraftCard bestCards[3], bool selectComboBoxes=true);
+    void addCardHist(QString code, bool premium, bool isHero=false, bool download=true);
+    void swapMatchState(DraftMatchState &state);
     QString degoldCode(QString fileName);
     void createScoreItems();
     void createSynergyHandler();
@@ -149,6 +249,13 @@ private:
     void deleteTwitchHandler();
     QString getDeckAvgString(int deckScoreLFNormalized, int deckScoreHA, float deckScoreHSR);
     void buildDraftMechanicsWindow();
+    void startHeroesHist();
+    static QMap<QString, cv::MatND> computeHeroesHist(const QStringList &codes);
+    float getLookaheadScore(const QString &code);
+    float getDeckRatingSum();
+    void buildLookaheadPool();
+    void startLookahead(DraftCard bestCards[3]);
+    void launchLookahead(const QList<LookaheadTask> &tasks, const QStringList &codes);
 
 public:
     void buildHeroCodesList();
@@ -167,9 +274,12 @@ public:
     bool isDrafting();
     void deMinimizeScoreWindow();
     QStringList getAllArenaCodes();
+    void updateTierStore();
+    void benchmarkDraftRecognition(const QString &dirPath);
     QStringList getAllHeroCodes();
     void setHeroWinratesMap(QMap<QString, float> &heroWinratesMap);
     void setCardsIncludedWinratesMap(QMap<QString, float> cardsIncludedWinratesMap[]);
+    void setCardsPickratesMap(QMap<QString, float> cardsPickratesMap[]);
     void setCardsIncludedDecksMap(QMap<QString, int> cardsIncludedDecksMap[]);
     void setCardsPlayedWinratesMap(QMap<QString, float> cardsPlayedWinratesMap[]);
     void updateTwitchChatVotes();
@@ -219,7 +329,10 @@ public slots:
 
 private slots:
     void captureDraft();
+    void finishCaptureDraft();
     void finishFindScreenRects();
+    void finishHeroesHist();
+    void finishLookahead();
     void startFindScreenRects();
     void comboBoxChanged();
     void refreshCapturedCards();
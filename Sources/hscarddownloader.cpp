@@ -170,6 +170,7 @@ void HSCardDownloader::saveWebImage(QNetworkReply * reply)
         }
         else
         {
+            Utility::addCardImage(code);
             emit pDebug("Card downloaded: " + code);
             emit downloaded(code);
         }
@@ -199,10 +200,11 @@ void HSCardDownloader::reuseOldHero(QString code)
         QString oldHeroCode = code.left(7);
         QFile heroFile(Utility::hscardsPath() + "/" + oldHeroCode + ".png");
 
-        if(heroFile.exists())
+        if(Utility::cardImageExists(oldHeroCode))
         {
             if(heroFile.copy(Utility::hscardsPath() + "/" + code + ".png"))
             {
+                Utility::addCardImage(code);
                 emit pDebug("Old hero reused: " + oldHeroCode);
                 emit downloaded(code);
             }
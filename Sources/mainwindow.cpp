@@ -335,6 +335,9 @@ void MainWindow::createCardsJsonMap(QByteArray &jsonData)
         QJsonObject jsonCardObject = jsonCard.toObject();
         cardsJson[jsonCardObject.value("id").toString()] = jsonCardObject;
     }
+    DeckCard::clearCardInfoCache();
+    Utility::buildCardsRuleData();
+    Utility::buildCardsNameIndex();
 
     cardsJsonLoaded = true;
     if(draftHandler != nullptr) draftHandler->buildHeroCodesList();
@@ -437,6 +440,7 @@ void MainWindow::replyFinished(QNetworkReply *reply)
             emit pDebug("Extra: Json LightForge github --> Download Success.");
             QByteArray jsonData = reply->readAll();
             Utility::dumpOnFile(jsonData, Utility::extraPath() + "/lightForge.json");
+            if(draftHandler != nullptr) draftHandler->updateTierStore();
             allCardsDownloadNeeded = true;
             lightForgeJsonLoaded = true;
             checkArenaCards();
@@ -453,6 +457,7 @@ void MainWindow::replyFinished(QNetworkReply *reply)
             emit pDebug("Extra: Json HearthArena --> Download Success.");
             QByteArray jsonData = reply->readAll();
             Utility::dumpOnFile(jsonData, Utility::extraPath() + "/hearthArena.json");
+            if(draftHandler != nullptr) draftHandler->updateTierStore();
         }
         //Synergies version
         else if(endUrl == "synergiesVersion.json")
@@ -538,6 +543,7 @@ void MainWindow::setLocalLang()
 {
     QString lang = getHSLanguage();
     Utility::setLocalLang(lang);
+    DeckCard::clearCardInfoCache();
 }
 
 
@@ -696,6 +702,7 @@ void MainWindow::finishProcessHSRCardsIncluded()
     this->cardsIncludedDecksMap = hsrCardsMaps.cardsIncludedDecksMap;
     draftHandler->setCardsIncludedWinratesMap(cardsIncludedWinratesMap);
     draftHandler->setCardsIncludedDecksMap(cardsIncludedDecksMap);
+    draftHandler->setCardsPickratesMap(cardsPickratesMap);
     secretsHandler->setCardsPickratesMap(cardsPickratesMap);
     secretsHandler->sortSecretsByPickrate(cardsPickratesMap);
     popularCardsHandler->setCardsPickratesMap(cardsPickratesMap);
@@ -787,6 +794,7 @@ void MainWindow::downloadLightForgeJson(const QJsonObject &jsonObject)
         {
             removeHSCards(true);
             Utility::createDir(Utility::hscardsPath());
+            Utility::buildCardImagesIndex();
         }
         else if(redownloadHeroes)
         {
@@ -807,6 +815,7 @@ void MainWindow::downloadLightForgeJson(const QJsonObject &jsonObject)
                 if(file.startsWith("HERO_0") || file.startsWith("HERO_1"))
                 {
                     dir.remove(file);
+                    Utility::removeCardImage(file.left(file.length()-4));
                     pDebug(file + " removed.");
                 }
             }
@@ -2612,9 +2621,7 @@ bool MainWindow::checkCardImage(QString code, bool isHero)
 {
     if(code.isEmpty())  return true;
 
-    QFileInfo cardFile(Utility::hscardsPath() + "/" + code + ".png");
-
-    if(!cardFile.exists())
+    if(!Utility::cardImageExists(code))
     {
         //La bajamos de Github/Hearthsim
         cardDownloader->downloadWebImage(code, isHero);
@@ -2712,6 +2719,7 @@ void MainWindow::createDataDir()
     if(REMOVE_CARDS_ON_VERSION_UPDATE)  removeHSCards();//Redownload HSCards en esta version
     if(REMOVE_EXTRA_ON_VERSION_UPDATE)  removeExtra();//Redownload Extra en esta version
     if(Utility::createDir(Utility::hscardsPath()))  allCardsDownloadNeeded = true;
+    Utility::buildCardImagesIndex();
     Utility::createDir(Utility::gameslogPath());
     Utility::createDir(Utility::extraPath());
     Utility::createDir(Utility::themesPath());
@@ -4615,6 +4623,28 @@ void MainWindow::testHeroPortraits()
 }
 
 
+void MainWindow::testCardNameIndex()
+{
+    Utility::benchmarkCardsNameIndex();
+    qDebug()<<"DEBUG NAME INDEX: Prefix \"rag\":"<<Utility::cardCodesFromNamePrefix("rag");
+    qDebug()<<"DEBUG NAME INDEX: Fuzzy \"Ragnaros Firelord\":"<<Utility::cardCodesFromNameFuzzy("Ragnaros Firelord");
+}
+
+
+//Screenshots + groundTruth.txt en DraftBenchmark (ver DraftHandler::benchmarkDraftRecognition)
+void MainWindow::testDraftRecognition()
+{
+    draftHandler->benchmarkDraftRecognition(Utility::dataPath() + "/DraftBenchmark");
+}
+
+
+//HsvHist (una pasada + SIMD) vs cvtColor + calcHist sobre recortes de hscards
+void MainWindow::testHsvHist()
+{
+    HsvHist::benchmark(Utility::hscardsPath());
+}
+
+
 void MainWindow::testSynergies()
 {
 //    qDebug()<<Utility::cardEnCodeFromName("Blur");
@@ -4666,6 +4696,9 @@ void MainWindow::testDelay()
 //    Utility::checkMissingGoldenCards();
 //    Utility::resizeGoldenCards();
 //    testDownloadCards();
+//    testCardNameIndex();
+//    testDraftRecognition();
+//    testHsvHist();
 //    QTimer::singleShot(7000, this, SLOT(testPopularList()));
 //    QTimer::singleShot(7000, this, SLOT(testSecretsHSR()));
 }
@@ -284,6 +284,9 @@ private slots:
     void testDelay();
     void testSynergies();
     void testHeroPortraits();
+    void testCardNameIndex();
+    void testDraftRecognition();
+    void testHsvHist();
     void testTierlists();
     void testDownloadCards();
     void testSecretsHSR();
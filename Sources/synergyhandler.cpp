@@ -5,6 +5,7 @@
 SynergyHandler::SynergyHandler(QObject *parent, Ui::Extended *ui) : QObject(parent)
 {
     this->ui = ui;
+    this->synergiesCacheVersion = 0;
 
     createDraftItemCounters();
 }
@@ -228,6 +229,7 @@ void SynergyHandler::deleteDraftItemCounters()
 
 void SynergyHandler::setTheme()
 {
+    synergiesCache.clear();//mechanicIcons usa los ficheros del tema
     cardTypeCounters[V_MINION]->setTheme(QPixmap(ThemeHandler::minionsCounterFile()));
     cardTypeCounters[V_SPELL]->setTheme(QPixmap(ThemeHandler::spellsCounterFile()));
     cardTypeCounters[V_WEAPON]->setTheme(QPixmap(ThemeHandler::weaponsCounterFile()));
@@ -269,8 +271,10 @@ void SynergyHandler::sendItemEnter(QList<DeckCard> &deckCardList, QRect &labelRe
 
 void SynergyHandler::initSynergyCodes()
 {
-    synergyCodes.clear();
+    synergyRules.clear();
     directLinks.clear();
+    cardCounterDataCache.clear();
+    synergiesCache.clear();
 
     QFile jsonFile(Utility::extraPath() + "/synergies.json");
     jsonFile.open(QIODevice::ReadOnly | QIODevice::Text);
@@ -282,15 +286,16 @@ void SynergyHandler::initSynergyCodes()
     {
         if(jsonObject.value(code).isArray())
         {
-            synergyCodes[code];
+            QStringList jsonKeys;
             QJsonArray synergies = jsonObject.value(code).toArray();
             for(QJsonArray::const_iterator it=synergies.constBegin(); it!=synergies.constEnd(); it++)
             {
-                synergyCodes[code].append(it->toString());
+                jsonKeys.append(it->toString());
             }
+            synergyRules[code] = CardSynergyRules(code, jsonKeys);
         }
     }
-    emit pDebug("Synergy Cards: " + QString::number(synergyCodes.count()));
+    emit pDebug("Synergy Cards: " + QString::number(synergyRules.count()));
 
 
     //Direct links
@@ -313,12 +318,16 @@ void SynergyHandler::initSynergyCodes()
 
 void SynergyHandler::clearLists(bool keepCounters)
 {
-    synergyCodes.clear();
+    synergyRules.clear();
     directLinks.clear();
+    cardCounterDataCache.clear();
+    synergiesCache.clear();
 
     if(!keepCounters)//endDraft
     {
         //Reset counters
+        deckState.reset();
+        synergyMatcher.reset();
         manaCounter->reset();
         for(int i=0; i<V_NUM_TYPES; i++)
         {
@@ -395,12 +404,7 @@ void SynergyHandler::setHidden(bool hide)
 
 int SynergyHandler::draftedCardsCount()
 {
-    int num = 0;
-    for(int i=0; i<V_NUM_TYPES; i++)
-    {
-        num += cardTypeCounters[i]->count();
-    }
-    return num;
+    return deckState.getDraftedCardsCount();
 }
 
 
@@ -458,37 +462,23 @@ int SynergyHandler::getCounters(QStringList &spellList, QStringList &minionList,
     codeMap2CodeList(mechanicCounters[V_DESTROY]->getCodeMap(), destroyList);
     codeMap2CodeList(mechanicCounters[V_REACH]->getCodeMap(), reachList);
 
-    discover = draw = toYourHand = 0;
-    QMap<QString, int> codeMap;
-    codeMap = mechanicCounters[V_DISCOVER]->getCodeMap();
-    for(const QString &code: codeMap.keys())
-    {
-        QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-        QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-        discover += codeMap[code] * numDiscoverGen(code, mechanics, referencedTags);
-    }
-    codeMap = mechanicCounters[V_DRAW]->getCodeMap();
-    for(const QString &code: codeMap.keys())
-    {
-        QString text = Utility::cardEnTextFromCode(code).toLower();
-        draw += codeMap[code] * numDrawGen(code, text);
-    }
-    codeMap = mechanicCounters[V_TOYOURHAND]->getCodeMap();
-    for(const QString &code: codeMap.keys())
-    {
-        QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-        QString text = Utility::cardEnTextFromCode(code).toLower();
-        int cost = Utility::getCardAttribute(code, "cost").toInt();
-        toYourHand += codeMap[code] * numToYourHandGen(code, cost, mechanics, text);
-    }
+    discover = deckState.getDiscover();
+    draw = deckState.getDraw();
+    toYourHand = deckState.getToYourHand();
 
-    return manaCounter->count();
+    return deckState.getTotalMana();
 }
 
 
 int SynergyHandler::getManaCounterCount()
 {
-    return manaCounter->count();
+    return deckState.getTotalMana();
+}
+
+
+const DraftDeckState &SynergyHandler::getDeckState()
+{
+    return deckState;
 }
 
 
@@ -496,376 +486,387 @@ void SynergyHandler::updateCounters(DeckCard &deckCard, QStringList &spellList,
                                     QStringList &drop2List, QStringList &drop3List, QStringList &drop4List,
                                     QStringList &aoeList, QStringList &tauntList, QStringList &survivabilityList, QStringList &drawList,
                                     QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList,
-                                    int &draw, int &toYourHand, int &discover)
+                                    int &draw, int &toYourHand, int &discover, int num)
 {
-    updateRaceCounters(deckCard);
-    updateCardTypeCounters(deckCard, spellList, minionList, weaponList);
-    updateDropCounters(deckCard, drop2List, drop3List, drop4List);
-    updateManaCounter(deckCard);
-    updateMechanicCounters(deckCard, aoeList, tauntList, survivabilityList, drawList, pingList, damageList, destroyList, reachList,
-                           draw, toYourHand, discover);
-    updateStatsCards(deckCard);
+    const QString code = deckCard.getCode();
+    const CardCounterData &data = getCardCounterData(deckCard);
+    deckState.addCard(data, num);
+    synergyMatcher.addCard(code, data, num);
+
+    for(int i=0; i<V_NUM_TYPES; i++)
+    {
+        if(data.typeGen[static_cast<size_t>(i)])        cardTypeCounters[i]->increase(code, num);
+    }
+    for(int i=0; i<V_NUM_RACES; i++)
+    {
+        if(data.raceGen[static_cast<size_t>(i)])        raceCounters[i]->increase(code, num);
+    }
+    for(int i=0; i<V_NUM_MECHANICS; i++)
+    {
+        //Evitamos que aparezcan token cards synergies en cada combo card
+        if(data.mechanicGen[static_cast<size_t>(i)] && i != V_TOKEN_CARD)   mechanicCounters[i]->increase(code, num);
+    }
+    if(data.drop != -1)     dropCounters[data.drop]->increase(code, num);
+    for(int i=0; i<V_NUM_DROPS; i++)
+    {
+        dropCounters[i]->setNumCards(deckState.getNumCards());
+    }
+    manaCounter->increase(num * data.mana, draftedCardsCount());
+
+    //Listas para draftMechanicsWindow
+    for(int i=0; i<num; i++)
+    {
+        if(data.typeGen[V_SPELL])                   spellList.append(code);
+        if(data.typeGen[V_MINION])                  minionList.append(code);
+        if(data.typeGen[V_WEAPON])                  weaponList.append(code);
+        if(data.drop == V_DROP2)                    drop2List.append(code);
+        else if(data.drop == V_DROP3)               drop3List.append(code);
+        else if(data.drop == V_DROP4)               drop4List.append(code);
+        if(data.mechanicGen[V_DISCOVER_DRAW])       drawList.append(code);
+        if(data.mechanicGen[V_AOE])                 aoeList.append(code);
+        if(data.mechanicGen[V_PING])                pingList.append(code);
+        if(data.mechanicGen[V_DAMAGE])              damageList.append(code);
+        if(data.mechanicGen[V_DESTROY])             destroyList.append(code);
+        if(data.mechanicGen[V_REACH])               reachList.append(code);
+        if(data.mechanicGen[V_SURVIVABILITY])       survivabilityList.append(code);
+        if(data.mechanicGen[V_TAUNT_ALL])           tauntList.append(code);
+
+        updateStatsCards(deckCard);
+    }
+
+    draw = num * data.draw;
+    toYourHand = num * data.toYourHand;
+    discover = num * data.discover;
 }
 
 
-void SynergyHandler::updateManaCounter(DeckCard &deckCard)
+//Evalua una vez los isXXXGen/isXXXSyn de todas las cartas del draft, justo despues de initSynergyCodes.
+//Durante el draft updateCounters y getSynergies solo leen sus bitsets.
+void SynergyHandler::precompileCardData(const QStringList &codes)
 {
-    manaCounter->increase(getCorrectedCardMana(deckCard), draftedCardsCount());
+    QElapsedTimer timer;
+    timer.start();
+
+    for(const QString &code: codes)
+    {
+        DeckCard deckCard(code);
+        getCardCounterData(deckCard);
+    }
+
+    emit pDebug("Synergy features: " + QString::number(cardCounterDataCache.count()) + " cards in " +
+                QString::number(timer.elapsed()) + " ms.");
+}
+
+
+//Los isXXXGen/isXXXSyn de una carta solo dependen de su code y de synergyRules.
+//Las cartas fuera de precompileCardData se calculan al usarlas.
+const CardCounterData &SynergyHandler::getCardCounterData(DeckCard &deckCard)
+{
+    const QString code = deckCard.getCode();
+    QHash<QString, CardCounterData>::const_iterator it = cardCounterDataCache.constFind(code);
+    if(it != cardCounterDataCache.constEnd())   return it.value();
+
+    CardCounterData data;
+    fillRaceCounterData(deckCard, data);
+    fillCardTypeCounterData(deckCard, data);
+    fillDropCounterData(deckCard, data);
+    fillMechanicCounterData(deckCard, data);
+    data.mana = getCorrectedCardMana(deckCard);
+    return cardCounterDataCache.insert(code, data).value();
 }
 
 
-void SynergyHandler::updateRaceCounters(DeckCard &deckCard)
+void SynergyHandler::fillRaceCounterData(DeckCard &deckCard, CardCounterData &data)
 {
     QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
+    QString text = Utility::getCardRuleData(code).text;
     CardRace cardRace = deckCard.getRace();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
+    CardTags mechanics = Utility::getCardRuleData(code).mechanics;
 
     if(cardRace == MURLOC)
     {
-        raceCounters[V_MURLOC]->increase(code);
-        raceCounters[V_MURLOC_ALL]->increase(code);
+        data.raceGen.set(V_MURLOC);
+        data.raceGen.set(V_MURLOC_ALL);
     }
-    else if(isMurlocGen(code))      raceCounters[V_MURLOC_ALL]->increase(code);
+    else if(isMurlocGen(code))      data.raceGen.set(V_MURLOC_ALL);
     if(cardRace == DEMON)
     {
-        raceCounters[V_DEMON]->increase(code);
-        raceCounters[V_DEMON_ALL]->increase(code);
+        data.raceGen.set(V_DEMON);
+        data.raceGen.set(V_DEMON_ALL);
     }
-    else if(isDemonGen(code))       raceCounters[V_DEMON_ALL]->increase(code);
+    else if(isDemonGen(code))       data.raceGen.set(V_DEMON_ALL);
     if(cardRace == MECHANICAL)
     {
-        raceCounters[V_MECHANICAL]->increase(code);
-        raceCounters[V_MECHANICAL_ALL]->increase(code);
+        data.raceGen.set(V_MECHANICAL);
+        data.raceGen.set(V_MECHANICAL_ALL);
     }
-    else if(isMechGen(code))        raceCounters[V_MECHANICAL_ALL]->increase(code);
+    else if(isMechGen(code))        data.raceGen.set(V_MECHANICAL_ALL);
     if(cardRace == ELEMENTAL)
     {
-        raceCounters[V_ELEMENTAL]->increase(code);
-        raceCounters[V_ELEMENTAL_ALL]->increase(code);
+        data.raceGen.set(V_ELEMENTAL);
+        data.raceGen.set(V_ELEMENTAL_ALL);
     }
-    else if(isElementalGen(code))   raceCounters[V_ELEMENTAL_ALL]->increase(code);
+    else if(isElementalGen(code))   data.raceGen.set(V_ELEMENTAL_ALL);
     if(cardRace == BEAST)
     {
-        raceCounters[V_BEAST]->increase(code);
-        raceCounters[V_BEAST_ALL]->increase(code);
+        data.raceGen.set(V_BEAST);
+        data.raceGen.set(V_BEAST_ALL);
     }
-    else if(isBeastGen(code))       raceCounters[V_BEAST_ALL]->increase(code);
+    else if(isBeastGen(code))       data.raceGen.set(V_BEAST_ALL);
     if(cardRace == TOTEM)
     {
-        raceCounters[V_TOTEM]->increase(code);
-        raceCounters[V_TOTEM_ALL]->increase(code);
+        data.raceGen.set(V_TOTEM);
+        data.raceGen.set(V_TOTEM_ALL);
     }
-    else if(isTotemGen(code))       raceCounters[V_TOTEM_ALL]->increase(code);
+    else if(isTotemGen(code))       data.raceGen.set(V_TOTEM_ALL);
     if(cardRace == PIRATE)
     {
-        raceCounters[V_PIRATE]->increase(code);
-        raceCounters[V_PIRATE_ALL]->increase(code);
+        data.raceGen.set(V_PIRATE);
+        data.raceGen.set(V_PIRATE_ALL);
     }
-    else if(isPirateGen(code))      raceCounters[V_PIRATE_ALL]->increase(code);
+    else if(isPirateGen(code))      data.raceGen.set(V_PIRATE_ALL);
     if(cardRace == DRAGON)
     {
-        raceCounters[V_DRAGON]->increase(code);
-        raceCounters[V_DRAGON_ALL]->increase(code);
+        data.raceGen.set(V_DRAGON);
+        data.raceGen.set(V_DRAGON_ALL);
     }
-    else if(isDragonGen(code))      raceCounters[V_DRAGON_ALL]->increase(code);
+    else if(isDragonGen(code))      data.raceGen.set(V_DRAGON_ALL);
 
-    if(isMurlocSyn(code))                           raceCounters[V_MURLOC]->increaseSyn(code);
-    else if(isMurlocAllSyn(code, text))             raceCounters[V_MURLOC_ALL]->increaseSyn(code);
-    if(isDemonSyn(code))                            raceCounters[V_DEMON]->increaseSyn(code);
-    else if(isDemonAllSyn(code, text))              raceCounters[V_DEMON_ALL]->increaseSyn(code);
-    if(isMechSyn(code))                             raceCounters[V_MECHANICAL]->increaseSyn(code);
-    else if(isMechAllSyn(code, mechanics, text))    raceCounters[V_MECHANICAL_ALL]->increaseSyn(code);
-    if(isElementalSyn(code))                        raceCounters[V_ELEMENTAL]->increaseSyn(code);
-    else if(isElementalAllSyn(code, text))          raceCounters[V_ELEMENTAL_ALL]->increaseSyn(code);
-    if(isBeastSyn(code))                            raceCounters[V_BEAST]->increaseSyn(code);
-    else if(isBeastAllSyn(code, text))              raceCounters[V_BEAST_ALL]->increaseSyn(code);
-    if(isTotemSyn(code))                            raceCounters[V_TOTEM]->increaseSyn(code);
-    else if(isTotemAllSyn(code, text))              raceCounters[V_TOTEM_ALL]->increaseSyn(code);
-    if(isPirateSyn(code))                           raceCounters[V_PIRATE]->increaseSyn(code);
-    else if(isPirateAllSyn(code, text))             raceCounters[V_PIRATE_ALL]->increaseSyn(code);
-    if(isDragonSyn(code, text))                     raceCounters[V_DRAGON]->increaseSyn(code);
-    else if(isDragonAllSyn(code))                   raceCounters[V_DRAGON_ALL]->increaseSyn(code);
+    if(isMurlocSyn(code))                           data.raceSyn.set(V_MURLOC);
+    else if(isMurlocAllSyn(code, text))             data.raceSyn.set(V_MURLOC_ALL);
+    if(isDemonSyn(code))                            data.raceSyn.set(V_DEMON);
+    else if(isDemonAllSyn(code, text))              data.raceSyn.set(V_DEMON_ALL);
+    if(isMechSyn(code))                             data.raceSyn.set(V_MECHANICAL);
+    else if(isMechAllSyn(code, mechanics, text))    data.raceSyn.set(V_MECHANICAL_ALL);
+    if(isElementalSyn(code))                        data.raceSyn.set(V_ELEMENTAL);
+    else if(isElementalAllSyn(code, text))          data.raceSyn.set(V_ELEMENTAL_ALL);
+    if(isBeastSyn(code))                            data.raceSyn.set(V_BEAST);
+    else if(isBeastAllSyn(code, text))              data.raceSyn.set(V_BEAST_ALL);
+    if(isTotemSyn(code))                            data.raceSyn.set(V_TOTEM);
+    else if(isTotemAllSyn(code, text))              data.raceSyn.set(V_TOTEM_ALL);
+    if(isPirateSyn(code))                           data.raceSyn.set(V_PIRATE);
+    else if(isPirateAllSyn(code, text))             data.raceSyn.set(V_PIRATE_ALL);
+    if(isDragonSyn(code, text))                     data.raceSyn.set(V_DRAGON);
+    else if(isDragonAllSyn(code))                   data.raceSyn.set(V_DRAGON_ALL);
 }
 
 
-void SynergyHandler::updateCardTypeCounters(DeckCard &deckCard, QStringList &spellList, QStringList &minionList, QStringList &weaponList)
+void SynergyHandler::fillCardTypeCounterData(DeckCard &deckCard, CardCounterData &data)
 {
     QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
+    QString text = Utility::getCardRuleData(code).text;
     CardType cardType = deckCard.getType();
 
     if(cardType == SPELL)
     {
-        cardTypeCounters[V_SPELL]->increase(code);
-        cardTypeCounters[V_SPELL_ALL]->increase(code);
-        spellList.append(code);
-    }
-    else if(isSpellGen(code))           cardTypeCounters[V_SPELL_ALL]->increase(code);
-    if(cardType == MINION || cardType == HERO)
-    {
-        cardTypeCounters[V_MINION]->increase(code);
-        minionList.append(code);
+        data.typeGen.set(V_SPELL);
+        data.typeGen.set(V_SPELL_ALL);
     }
+    else if(isSpellGen(code))           data.typeGen.set(V_SPELL_ALL);
+    if(cardType == MINION || cardType == HERO)  data.typeGen.set(V_MINION);
     if(cardType == WEAPON)
     {
-        cardTypeCounters[V_WEAPON]->increase(code);
-        cardTypeCounters[V_WEAPON_ALL]->increase(code);
-        weaponList.append(code);
+        data.typeGen.set(V_WEAPON);
+        data.typeGen.set(V_WEAPON_ALL);
     }
-    else if(isWeaponGen(code, text))    cardTypeCounters[V_WEAPON_ALL]->increase(code);
+    else if(isWeaponGen(code, text))    data.typeGen.set(V_WEAPON_ALL);
 
 
-    if(isSpellSyn(code))                cardTypeCounters[V_SPELL]->increaseSyn(code);
-    else if(isSpellAllSyn(code, text))  cardTypeCounters[V_SPELL_ALL]->increaseSyn(code);
-    if(isWeaponSyn(code))               cardTypeCounters[V_WEAPON]->increaseSyn(code);
-    else if(isWeaponAllSyn(code, text)) cardTypeCounters[V_WEAPON_ALL]->increaseSyn(code);
+    if(isSpellSyn(code))                data.typeSyn.set(V_SPELL);
+    else if(isSpellAllSyn(code, text))  data.typeSyn.set(V_SPELL_ALL);
+    if(isWeaponSyn(code))               data.typeSyn.set(V_WEAPON);
+    else if(isWeaponAllSyn(code, text)) data.typeSyn.set(V_WEAPON_ALL);
 }
 
 
-void SynergyHandler::updateDropCounters(DeckCard &deckCard, QStringList &drop2List, QStringList &drop3List, QStringList &drop4List)
+void SynergyHandler::fillDropCounterData(DeckCard &deckCard, CardCounterData &data)
 {
     QString code = deckCard.getCode();
     int cost = deckCard.getCost();
 
-    if(isDrop2(code, cost))
-    {
-        dropCounters[V_DROP2]->increase(code);
-        drop2List.append(code);
-    }
-    else if(isDrop3(code, cost))
-    {
-        dropCounters[V_DROP3]->increase(code);
-        drop3List.append(code);
-    }
-    else if(isDrop4(code, cost))
-    {
-        dropCounters[V_DROP4]->increase(code);
-        drop4List.append(code);
-    }
-
-    //Hay una carta mas en el mazo
-    for(int i=0; i<V_NUM_DROPS; i++)
-    {
-        dropCounters[i]->increaseNumCards();
-    }
+    if(isDrop2(code, cost))         data.drop = V_DROP2;
+    else if(isDrop3(code, cost))    data.drop = V_DROP3;
+    else if(isDrop4(code, cost))    data.drop = V_DROP4;
 }
 
 
-void SynergyHandler::updateMechanicCounters(DeckCard &deckCard,
-                                            QStringList &aoeList, QStringList &tauntList, QStringList &survivabilityList, QStringList &drawList,
-                                            QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList,
-                                            int &draw, int &toYourHand, int &discover)
+void SynergyHandler::fillMechanicCounterData(DeckCard &deckCard, CardCounterData &data)
 {
     bool isSurvivability = false;
     QString code = deckCard.getCode();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
+    CardTags mechanics = Utility::getCardRuleData(code).mechanics;
+    CardTags referencedTags = Utility::getCardRuleData(code).referencedTags;
+    QString text = Utility::getCardRuleData(code).text;
     CardType cardType = deckCard.getType();
     CardClass cardClass = deckCard.getCardClass();
     int attack = Utility::getCardAttribute(code, "attack").toInt();
     int cost = deckCard.getCost();
 
     //GEN
-    if(isDiscoverDrawGen(code, cost, mechanics, referencedTags, text))
-    {
-        mechanicCounters[V_DISCOVER_DRAW]->increase(code);
-        drawList.append(code);
-    }
-    if(isAoeGen(code, text))
-    {
-        mechanicCounters[V_AOE]->increase(code);
-        aoeList.append(code);
-    }
-    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_PING]->increase(code);
-        pingList.append(code);
-    }
-    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_DAMAGE]->increase(code);
-        damageList.append(code);
-    }
-    if(isDestroyGen(code, mechanics, text))
-    {
-        mechanicCounters[V_DESTROY]->increase(code);
-        destroyList.append(code);
-    }
-    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_REACH]->increase(code);
-        reachList.append(code);
-    }
+    if(isDiscoverDrawGen(code, cost, mechanics, referencedTags, text))      data.mechanicGen.set(V_DISCOVER_DRAW);
+    if(isAoeGen(code, text))                                                data.mechanicGen.set(V_AOE);
+    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))  data.mechanicGen.set(V_PING);
+    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack)) data.mechanicGen.set(V_DAMAGE);
+    if(isDestroyGen(code, mechanics, text))                                 data.mechanicGen.set(V_DESTROY);
+    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack)) data.mechanicGen.set(V_REACH);
     if(isRestoreFriendlyHeroGen(code, mechanics, referencedTags, text))
     {
-        mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->increase(code);
+        data.mechanicGen.set(V_RESTORE_FRIENDLY_HEROE);
         isSurvivability = true;
     }
     if(isArmorGen(code, text))
     {
-        mechanicCounters[V_ARMOR]->increase(code);
+        data.mechanicGen.set(V_ARMOR);
         isSurvivability = true;
     }
-    if(isSurvivability)
-    {
-        mechanicCounters[V_SURVIVABILITY]->increase(code);
-        survivabilityList.append(code);
-    }
-    discover = numDiscoverGen(code, mechanics, referencedTags);
-    draw = numDrawGen(code, text);
-    toYourHand = numToYourHandGen(code, cost, mechanics, text);
-    if(discover > 0)                                                        mechanicCounters[V_DISCOVER]->increase(code);
-    if(draw > 0)                                                            mechanicCounters[V_DRAW]->increase(code);
-    if(toYourHand > 0)                                                      mechanicCounters[V_TOYOURHAND]->increase(code);
-    if(isOverload(code))                                                    mechanicCounters[V_OVERLOAD]->increase(code);
-    if(isJadeGolemGen(code, mechanics, referencedTags))                     mechanicCounters[V_JADE_GOLEM]->increase(code);
-    if(isHeroPowerGen(code, text, cardClass))                               mechanicCounters[V_HERO_POWER]->increase(code);
-    if(isFreezeEnemyGen(code, mechanics, referencedTags, text))             mechanicCounters[V_FREEZE_ENEMY]->increase(code);
-    if(isDiscardGen(code, text))                                            mechanicCounters[V_DISCARD]->increase(code);
-    if(isDeathrattleMinion(code, mechanics, cardType))                      mechanicCounters[V_DEATHRATTLE]->increase(code);
-    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType))     mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->increase(code);
-    if(isSilenceOwnGen(code, mechanics, referencedTags))                    mechanicCounters[V_SILENCE]->increase(code);
-    if(isTauntGiverGen(code))                                               mechanicCounters[V_TAUNT_GIVER]->increase(code);
-    if(isTokenGen(code, text))                                              mechanicCounters[V_TOKEN]->increase(code);
-    //TokenCard es synergia debil
-    //Evitamos que aparezcan token cards synergies en cada combo card
-//    if(isTokenCardGen(code, cost))                                          mechanicCounters[V_TOKEN_CARD]->increase(code);
-    if(isComboGen(code, mechanics))                                         mechanicCounters[V_COMBO]->increase(code);
-    if(isWindfuryMinion(code, mechanics, cardType))                         mechanicCounters[V_WINDFURY_MINION]->increase(code);
-    if(isAttackBuffGen(code, text))                                         mechanicCounters[V_ATTACK_BUFF]->increase(code);
-    if(isHealthBuffGen(code, text))                                         mechanicCounters[V_HEALTH_BUFF]->increase(code);
-    if(isReturnGen(code, text))                                             mechanicCounters[V_RETURN]->increase(code);
-    if(isStealthGen(code, mechanics))                                       mechanicCounters[V_STEALTH]->increase(code);
-    if(isSpellDamageGen(code))                                              mechanicCounters[V_SPELL_DAMAGE]->increase(code);
-    if(isEvolveGen(code, text))                                             mechanicCounters[V_EVOLVE]->increase(code);
-    if(isSpawnEnemyGen(code, text))                                         mechanicCounters[V_SPAWN_ENEMY]->increase(code);
-    if(isRestoreTargetMinionGen(code, text))                                mechanicCounters[V_RESTORE_TARGET_MINION]->increase(code);
-    if(isRestoreFriendlyMinionGen(code, text))                              mechanicCounters[V_RESTORE_FRIENDLY_MINION]->increase(code);
-    if(isEnrageGen(code, mechanics))                                        mechanicCounters[V_ENRAGED]->increase(code);
-    if(isEggGen(code, mechanics, attack, cardType))                         mechanicCounters[V_EGG]->increase(code);
-    if(isDamageFriendlyHeroGen(code))                                       mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->increase(code);
-    if(isHandBuffGen(code, text))                                           mechanicCounters[V_HAND_BUFF]->increase(code);
-    if(isEnemyDrawGen(code, text))                                          mechanicCounters[V_ENEMY_DRAW]->increase(code);
-    if(isHeroAttackGen(code, text))                                         mechanicCounters[V_HERO_ATTACK]->increase(code);
-    if(isSpellBuffGen(code, text, mechanics, cardType))                     mechanicCounters[V_SPELL_BUFF]->increase(code);
-    if(isOtherClassGen(code, text, cardClass))                              mechanicCounters[V_OTHER_CLASS]->increase(code);
-    if(isSilverHandGen(code, text, cardClass))                              mechanicCounters[V_SILVER_HAND]->increase(code);
-    if(isTreantGen(code, text, cardClass))                                  mechanicCounters[V_TREANT]->increase(code);
-    if(isLackeyGen(code, text))                                             mechanicCounters[V_LACKEY]->increase(code);
+    if(isSurvivability)                                                     data.mechanicGen.set(V_SURVIVABILITY);
+    data.discover = numDiscoverGen(code, mechanics, referencedTags);
+    data.draw = numDrawGen(code, text);
+    data.toYourHand = numToYourHandGen(code, cost, mechanics, text);
+    if(data.discover > 0)                                                   data.mechanicGen.set(V_DISCOVER);
+    if(data.draw > 0)                                                       data.mechanicGen.set(V_DRAW);
+    if(data.toYourHand > 0)                                                 data.mechanicGen.set(V_TOYOURHAND);
+    if(isOverload(code))                                                    data.mechanicGen.set(V_OVERLOAD);
+    if(isJadeGolemGen(code, mechanics, referencedTags))                     data.mechanicGen.set(V_JADE_GOLEM);
+    if(isHeroPowerGen(code, text, cardClass))                               data.mechanicGen.set(V_HERO_POWER);
+    if(isFreezeEnemyGen(code, mechanics, referencedTags, text))             data.mechanicGen.set(V_FREEZE_ENEMY);
+    if(isDiscardGen(code, text))                                            data.mechanicGen.set(V_DISCARD);
+    if(isDeathrattleMinion(code, mechanics, cardType))                      data.mechanicGen.set(V_DEATHRATTLE);
+    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType))     data.mechanicGen.set(V_DEATHRATTLE_GOOD_ALL);
+    if(isSilenceOwnGen(code, mechanics, referencedTags))                    data.mechanicGen.set(V_SILENCE);
+    if(isTauntGiverGen(code))                                               data.mechanicGen.set(V_TAUNT_GIVER);
+    if(isTokenGen(code, text))                                              data.mechanicGen.set(V_TOKEN);
+    //TokenCard es synergia debil, no se cuenta en mechanicCounters (ver updateCounters)
+    if(isTokenCardGen(code, cost, mechanics, text))                         data.mechanicGen.set(V_TOKEN_CARD);
+    if(isComboGen(code, mechanics))                                         data.mechanicGen.set(V_COMBO);
+    if(isWindfuryMinion(code, mechanics, cardType))                         data.mechanicGen.set(V_WINDFURY_MINION);
+    if(isAttackBuffGen(code, text))                                         data.mechanicGen.set(V_ATTACK_BUFF);
+    if(isHealthBuffGen(code, text))                                         data.mechanicGen.set(V_HEALTH_BUFF);
+    if(isReturnGen(code, text))                                             data.mechanicGen.set(V_RETURN);
+    if(isStealthGen(code, mechanics))                                       data.mechanicGen.set(V_STEALTH);
+    if(isSpellDamageGen(code))                                              data.mechanicGen.set(V_SPELL_DAMAGE);
+    if(isEvolveGen(code, text))                                             data.mechanicGen.set(V_EVOLVE);
+    if(isSpawnEnemyGen(code, text))                                         data.mechanicGen.set(V_SPAWN_ENEMY);
+    if(isRestoreTargetMinionGen(code, text))                                data.mechanicGen.set(V_RESTORE_TARGET_MINION);
+    if(isRestoreFriendlyMinionGen(code, text))                              data.mechanicGen.set(V_RESTORE_FRIENDLY_MINION);
+    if(isEnrageGen(code, mechanics))                                        data.mechanicGen.set(V_ENRAGED);
+    if(isEggGen(code, mechanics, attack, cardType))                         data.mechanicGen.set(V_EGG);
+    if(isDamageFriendlyHeroGen(code))                                       data.mechanicGen.set(V_DAMAGE_FRIENDLY_HERO);
+    if(isHandBuffGen(code, text))                                           data.mechanicGen.set(V_HAND_BUFF);
+    if(isEnemyDrawGen(code, text))                                          data.mechanicGen.set(V_ENEMY_DRAW);
+    if(isHeroAttackGen(code, text))                                         data.mechanicGen.set(V_HERO_ATTACK);
+    if(isSpellBuffGen(code, text, mechanics, cardType))                     data.mechanicGen.set(V_SPELL_BUFF);
+    if(isOtherClassGen(code, text, cardClass))                              data.mechanicGen.set(V_OTHER_CLASS);
+    if(isSilverHandGen(code, text, cardClass))                              data.mechanicGen.set(V_SILVER_HAND);
+    if(isTreantGen(code, text, cardClass))                                  data.mechanicGen.set(V_TREANT);
+    if(isLackeyGen(code, text))                                             data.mechanicGen.set(V_LACKEY);
     //New Synergy Step 3
     if(isTaunt(code, mechanics))
     {
-        mechanicCounters[V_TAUNT]->increase(code);
-        mechanicCounters[V_TAUNT_ALL]->increase(code);
-        tauntList.append(code);
-    }
-    else if(isTauntGen(code, referencedTags))
-    {
-        mechanicCounters[V_TAUNT_ALL]->increase(code);
-        tauntList.append(code);
+        data.mechanicGen.set(V_TAUNT);
+        data.mechanicGen.set(V_TAUNT_ALL);
     }
+    else if(isTauntGen(code, referencedTags))    data.mechanicGen.set(V_TAUNT_ALL);
     if(isDivineShield(code, mechanics))
     {
-        mechanicCounters[V_DIVINE_SHIELD]->increase(code);
-        mechanicCounters[V_DIVINE_SHIELD_ALL]->increase(code);
+        data.mechanicGen.set(V_DIVINE_SHIELD);
+        data.mechanicGen.set(V_DIVINE_SHIELD_ALL);
     }
-    else if(isDivineShieldGen(code, referencedTags))                        mechanicCounters[V_DIVINE_SHIELD_ALL]->increase(code);
+    else if(isDivineShieldGen(code, referencedTags))                        data.mechanicGen.set(V_DIVINE_SHIELD_ALL);
     if(isSecret(code, mechanics))
     {
-        mechanicCounters[V_SECRET]->increase(code);
-        mechanicCounters[V_SECRET_ALL]->increase(code);
+        data.mechanicGen.set(V_SECRET);
+        data.mechanicGen.set(V_SECRET_ALL);
     }
-    else if(isSecretGen(code))                                              mechanicCounters[V_SECRET_ALL]->increase(code);
+    else if(isSecretGen(code))                                              data.mechanicGen.set(V_SECRET_ALL);
     if(isEcho(code, mechanics))
     {
-        mechanicCounters[V_ECHO]->increase(code);
-        mechanicCounters[V_ECHO_ALL]->increase(code);
+        data.mechanicGen.set(V_ECHO);
+        data.mechanicGen.set(V_ECHO_ALL);
     }
-    else if(isEchoGen(code, referencedTags))                                mechanicCounters[V_ECHO_ALL]->increase(code);
+    else if(isEchoGen(code, referencedTags))                                data.mechanicGen.set(V_ECHO_ALL);
     if(isRush(code, mechanics))
     {
-        mechanicCounters[V_RUSH]->increase(code);
-        mechanicCounters[V_RUSH_ALL]->increase(code);
+        data.mechanicGen.set(V_RUSH);
+        data.mechanicGen.set(V_RUSH_ALL);
     }
-    else if(isRushGen(code, referencedTags))                                mechanicCounters[V_RUSH_ALL]->increase(code);
+    else if(isRushGen(code, referencedTags))                                data.mechanicGen.set(V_RUSH_ALL);
     if(isMagnetic(code, mechanics))
     {
-        mechanicCounters[V_MAGNETIC]->increase(code);
-        mechanicCounters[V_MAGNETIC_ALL]->increase(code);
+        data.mechanicGen.set(V_MAGNETIC);
+        data.mechanicGen.set(V_MAGNETIC_ALL);
     }
-    else if(isMagneticGen(code))                                            mechanicCounters[V_MAGNETIC_ALL]->increase(code);
+    else if(isMagneticGen(code))                                            data.mechanicGen.set(V_MAGNETIC_ALL);
     if(isLifestealMinon(code, mechanics, cardType))
     {
-        mechanicCounters[V_LIFESTEAL_MINION]->increase(code);
-        mechanicCounters[V_LIFESTEAL_ALL]->increase(code);
+        data.mechanicGen.set(V_LIFESTEAL_MINION);
+        data.mechanicGen.set(V_LIFESTEAL_ALL);
     }
-    else if(isLifestealGen(code, referencedTags))                           mechanicCounters[V_LIFESTEAL_ALL]->increase(code);
+    else if(isLifestealGen(code, referencedTags))                           data.mechanicGen.set(V_LIFESTEAL_ALL);
     if(isBattlecry(code, mechanics))
     {
-        mechanicCounters[V_BATTLECRY]->increase(code);
-        mechanicCounters[V_BATTLECRY_ALL]->increase(code);
+        data.mechanicGen.set(V_BATTLECRY);
+        data.mechanicGen.set(V_BATTLECRY_ALL);
     }
-    else if(isBattlecryGen(code))                                           mechanicCounters[V_BATTLECRY_ALL]->increase(code);
+    else if(isBattlecryGen(code))                                           data.mechanicGen.set(V_BATTLECRY_ALL);
 
 
     //SYN
-    if(isAoeSyn(code))                                                      mechanicCounters[V_AOE]->increaseSyn(code);
-    if(isPingSyn(code))                                                     mechanicCounters[V_PING]->increaseSyn(code);
-    if(isDiscoverSyn(code))                                                 mechanicCounters[V_DISCOVER]->increaseSyn(code);
-    if(isDrawSyn(code))                                                     mechanicCounters[V_DRAW]->increaseSyn(code);
-    if(isToYourHandSyn(code))                                               mechanicCounters[V_TOYOURHAND]->increaseSyn(code);
-    if(isOverloadSyn(code, text))                                           mechanicCounters[V_OVERLOAD]->increaseSyn(code);
-    if(isFreezeEnemySyn(code, referencedTags, text))                        mechanicCounters[V_FREEZE_ENEMY]->increaseSyn(code);
-    if(isDiscardSyn(code, text))                                            mechanicCounters[V_DISCARD]->increaseSyn(code);
-    if(isSilenceOwnSyn(code, mechanics))                                    mechanicCounters[V_SILENCE]->increaseSyn(code);
-    if(isTauntGiverSyn(code, mechanics, attack, cardType))                  mechanicCounters[V_TAUNT_GIVER]->increaseSyn(code);
-    if(isTokenSyn(code, text))                                              mechanicCounters[V_TOKEN]->increaseSyn(code);
-    if(isTokenCardSyn(code, text))                                          mechanicCounters[V_TOKEN_CARD]->increaseSyn(code);
-    if(isComboSyn(code, referencedTags))                                    mechanicCounters[V_COMBO]->increaseSyn(code);
-    if(isWindfuryMinionSyn(code))                                           mechanicCounters[V_WINDFURY_MINION]->increaseSyn(code);
-    if(isAttackBuffSyn(code, mechanics, attack, cardType))                  mechanicCounters[V_ATTACK_BUFF]->increaseSyn(code);
-    if(isHealthBuffSyn(code))                                               mechanicCounters[V_HEALTH_BUFF]->increaseSyn(code);
-    if(isReturnSyn(code, mechanics, cardType, text))                        mechanicCounters[V_RETURN]->increaseSyn(code);
-    if(isStealthSyn(code))                                                  mechanicCounters[V_STEALTH]->increaseSyn(code);
-    if(isSpellDamageSyn(code, mechanics, cardType, text))                   mechanicCounters[V_SPELL_DAMAGE]->increaseSyn(code);
-    if(isEvolveSyn(code))                                                   mechanicCounters[V_EVOLVE]->increaseSyn(code);
-    if(isSpawnEnemySyn(code))                                               mechanicCounters[V_SPAWN_ENEMY]->increaseSyn(code);
-    if(isRestoreTargetMinionSyn(code))                                      mechanicCounters[V_RESTORE_TARGET_MINION]->increaseSyn(code);
-    if(isRestoreFriendlyHeroSyn(code))                                      mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->increaseSyn(code);
-    if(isRestoreFriendlyMinionSyn(code))                                    mechanicCounters[V_RESTORE_FRIENDLY_MINION]->increaseSyn(code);
-    if(isArmorSyn(code))                                                    mechanicCounters[V_ARMOR]->increaseSyn(code);
-    if(isEnrageSyn(code, text))                                             mechanicCounters[V_ENRAGED]->increaseSyn(code);
-    if(isEggSyn(code, text))                                                mechanicCounters[V_EGG]->increaseSyn(code);
-    if(isDamageFriendlyHeroSyn(code))                                       mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->increaseSyn(code);
-    if(isHandBuffSyn(code, text))                                           mechanicCounters[V_HAND_BUFF]->increaseSyn(code);
-    if(isEnemyDrawSyn(code, text))                                          mechanicCounters[V_ENEMY_DRAW]->increaseSyn(code);
-    if(isHeroAttackSyn(code))                                               mechanicCounters[V_HERO_ATTACK]->increaseSyn(code);
-    if(isSpellBuffSyn(code, text))                                          mechanicCounters[V_SPELL_BUFF]->increaseSyn(code);
-    if(isOtherClassSyn(code, text, cardClass))                              mechanicCounters[V_OTHER_CLASS]->increaseSyn(code);
-    if(isSilverHandSyn(code))                                               mechanicCounters[V_SILVER_HAND]->increaseSyn(code);
-    if(isTreantSyn(code))                                                   mechanicCounters[V_TREANT]->increaseSyn(code);
-    if(isLackeySyn(code))                                                   mechanicCounters[V_LACKEY]->increaseSyn(code);
+    if(isAoeSyn(code))                                                      data.mechanicSyn.set(V_AOE);
+    if(isPingSyn(code))                                                     data.mechanicSyn.set(V_PING);
+    if(isDiscoverSyn(code))                                                 data.mechanicSyn.set(V_DISCOVER);
+    if(isDrawSyn(code))                                                     data.mechanicSyn.set(V_DRAW);
+    if(isToYourHandSyn(code))                                               data.mechanicSyn.set(V_TOYOURHAND);
+    if(isOverloadSyn(code, text))                                           data.mechanicSyn.set(V_OVERLOAD);
+    if(isFreezeEnemySyn(code, referencedTags, text))                        data.mechanicSyn.set(V_FREEZE_ENEMY);
+    if(isDiscardSyn(code, text))                                            data.mechanicSyn.set(V_DISCARD);
+    if(isSilenceOwnSyn(code, mechanics))                                    data.mechanicSyn.set(V_SILENCE);
+    if(isTauntGiverSyn(code, mechanics, attack, cardType))                  data.mechanicSyn.set(V_TAUNT_GIVER);
+    if(isTokenSyn(code, text))                                              data.mechanicSyn.set(V_TOKEN);
+    if(isTokenCardSyn(code, text))                                          data.mechanicSyn.set(V_TOKEN_CARD);
+    if(isComboSyn(code, referencedTags))                                    data.mechanicSyn.set(V_COMBO);
+    if(isWindfuryMinionSyn(code))                                           data.mechanicSyn.set(V_WINDFURY_MINION);
+    if(isAttackBuffSyn(code, mechanics, attack, cardType))                  data.mechanicSyn.set(V_ATTACK_BUFF);
+    if(isHealthBuffSyn(code))                                               data.mechanicSyn.set(V_HEALTH_BUFF);
+    if(isReturnSyn(code, mechanics, cardType, text))                        data.mechanicSyn.set(V_RETURN);
+    if(isStealthSyn(code))                                                  data.mechanicSyn.set(V_STEALTH);
+    if(isSpellDamageSyn(code, mechanics, cardType, text))                   data.mechanicSyn.set(V_SPELL_DAMAGE);
+    if(isEvolveSyn(code))                                                   data.mechanicSyn.set(V_EVOLVE);
+    if(isSpawnEnemySyn(code))                                               data.mechanicSyn.set(V_SPAWN_ENEMY);
+    if(isRestoreTargetMinionSyn(code))                                      data.mechanicSyn.set(V_RESTORE_TARGET_MINION);
+    if(isRestoreFriendlyHeroSyn(code))                                      data.mechanicSyn.set(V_RESTORE_FRIENDLY_HEROE);
+    if(isRestoreFriendlyMinionSyn(code))                                    data.mechanicSyn.set(V_RESTORE_FRIENDLY_MINION);
+    if(isArmorSyn(code))                                                    data.mechanicSyn.set(V_ARMOR);
+    if(isEnrageSyn(code, text))                                             data.mechanicSyn.set(V_ENRAGED);
+    if(isEggSyn(code, text))                                                data.mechanicSyn.set(V_EGG);
+    if(isDamageFriendlyHeroSyn(code))                                       data.mechanicSyn.set(V_DAMAGE_FRIENDLY_HERO);
+    if(isHandBuffSyn(code, text))                                           data.mechanicSyn.set(V_HAND_BUFF);
+    if(isEnemyDrawSyn(code, text))                                          data.mechanicSyn.set(V_ENEMY_DRAW);
+    if(isHeroAttackSyn(code))                                               data.mechanicSyn.set(V_HERO_ATTACK);
+    if(isSpellBuffSyn(code, text))                                          data.mechanicSyn.set(V_SPELL_BUFF);
+    if(isOtherClassSyn(code, text, cardClass))                              data.mechanicSyn.set(V_OTHER_CLASS);
+    if(isSilverHandSyn(code))                                               data.mechanicSyn.set(V_SILVER_HAND);
+    if(isTreantSyn(code))                                                   data.mechanicSyn.set(V_TREANT);
+    if(isLackeySyn(code))                                                   data.mechanicSyn.set(V_LACKEY);
     //New Synergy Step 4
-    if(isTauntSyn(code))                                                    mechanicCounters[V_TAUNT]->increaseSyn(code);
-    else if(isTauntAllSyn(code))                                            mechanicCounters[V_TAUNT_ALL]->increaseSyn(code);
-    if(isDeathrattleSyn(code))                                              mechanicCounters[V_DEATHRATTLE]->increaseSyn(code);
-    else if(isDeathrattleGoodAllSyn(code))                                  mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->increaseSyn(code);
-    if(isDivineShieldSyn(code))                                             mechanicCounters[V_DIVINE_SHIELD]->increaseSyn(code);
-    else if(isDivineShieldAllSyn(code))                                     mechanicCounters[V_DIVINE_SHIELD_ALL]->increaseSyn(code);
-    if(isSecretSyn(code))                                                   mechanicCounters[V_SECRET]->increaseSyn(code);
-    else if(isSecretAllSyn(code, referencedTags))                           mechanicCounters[V_SECRET_ALL]->increaseSyn(code);
-    if(isEchoSyn(code))                                                     mechanicCounters[V_ECHO]->increaseSyn(code);
-    else if(isEchoAllSyn(code))                                             mechanicCounters[V_ECHO_ALL]->increaseSyn(code);
-    if(isRushSyn(code))                                                     mechanicCounters[V_RUSH]->increaseSyn(code);
-    else if(isRushAllSyn(code))                                             mechanicCounters[V_RUSH_ALL]->increaseSyn(code);
-    if(isMagneticSyn(code))                                                 mechanicCounters[V_MAGNETIC]->increaseSyn(code);
-    else if(isMagneticAllSyn(code))                                         mechanicCounters[V_MAGNETIC_ALL]->increaseSyn(code);
-    if(isLifestealMinionSyn(code))                                          mechanicCounters[V_LIFESTEAL_MINION]->increaseSyn(code);
-    else if(isLifestealAllSyn(code))                                        mechanicCounters[V_LIFESTEAL_ALL]->increaseSyn(code);
-    if(isBattlecrySyn(code))                                                mechanicCounters[V_BATTLECRY]->increaseSyn(code);
-    else if(isBattlecryAllSyn(code, referencedTags))                        mechanicCounters[V_BATTLECRY_ALL]->increaseSyn(code);
+    if(isTauntSyn(code))                                                    data.mechanicSyn.set(V_TAUNT);
+    else if(isTauntAllSyn(code))                                            data.mechanicSyn.set(V_TAUNT_ALL);
+    if(isDeathrattleSyn(code))                                              data.mechanicSyn.set(V_DEATHRATTLE);
+    else if(isDeathrattleGoodAllSyn(code))                                  data.mechanicSyn.set(V_DEATHRATTLE_GOOD_ALL);
+    if(isDivineShieldSyn(code))                                             data.mechanicSyn.set(V_DIVINE_SHIELD);
+    else if(isDivineShieldAllSyn(code))                                     data.mechanicSyn.set(V_DIVINE_SHIELD_ALL);
+    if(isSecretSyn(code))                                                   data.mechanicSyn.set(V_SECRET);
+    else if(isSecretAllSyn(code, referencedTags))                           data.mechanicSyn.set(V_SECRET_ALL);
+    if(isEchoSyn(code))                                                     data.mechanicSyn.set(V_ECHO);
+    else if(isEchoAllSyn(code))                                             data.mechanicSyn.set(V_ECHO_ALL);
+    if(isRushSyn(code))                                                     data.mechanicSyn.set(V_RUSH);
+    else if(isRushAllSyn(code))                                             data.mechanicSyn.set(V_RUSH_ALL);
+    if(isMagneticSyn(code))                                                 data.mechanicSyn.set(V_MAGNETIC);
+    else if(isMagneticAllSyn(code))                                         data.mechanicSyn.set(V_MAGNETIC_ALL);
+    if(isLifestealMinionSyn(code))                                          data.mechanicSyn.set(V_LIFESTEAL_MINION);
+    else if(isLifestealAllSyn(code))                                        data.mechanicSyn.set(V_LIFESTEAL_ALL);
+    if(isBattlecrySyn(code))                                                data.mechanicSyn.set(V_BATTLECRY);
+    else if(isBattlecryAllSyn(code, referencedTags))                        data.mechanicSyn.set(V_BATTLECRY_ALL);
 }
 
 
@@ -899,7 +900,7 @@ void SynergyHandler::updateStatsCards(DeckCard &deckCard)
 //    }
 
     //Synergies
-    QList<StatSyn> statSyns = StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);
+    const QList<StatSyn> statSyns = synergyRules.value(code).statSyns;
     for(const StatSyn &statSyn: statSyns)
     {
         switch(statSyn.cardType)
@@ -962,352 +963,65 @@ void SynergyHandler::updateStatsCards(DeckCard &deckCard)
 }
 
 
+//Las sinergias de una carta solo cambian al cambiar el mazo (pick) o synergies.json.
+//Recapturas y cambios de comboBox reutilizan el resultado.
 void SynergyHandler::getSynergies(DeckCard &deckCard, QMap<QString,int> &synergies, QMap<QString, int> &mechanicIcons,
                                   MechanicBorderColor &dropBorderColor)
 {
-    getCardTypeSynergies(deckCard, synergies);
-    getDropMechanicIcons(deckCard, mechanicIcons, dropBorderColor);
-    getRaceSynergies(deckCard, synergies);
-    getMechanicSynergies(deckCard, synergies, mechanicIcons);
-    getDirectLinkSynergies(deckCard, synergies);
-    getStatsCardsSynergies(deckCard, synergies);
-}
-
-
-void SynergyHandler::getCardTypeSynergies(DeckCard &deckCard, QMap<QString,int> &synergies)
-{
-    QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
-
-    //Evita mostrar spellSyn cards en cada hechizo que veamos
-//    if(cardType == SPELL)
-//    {
-//        cardTypeCounters[V_SPELL]->insertSynCards(synergies);
-//        cardTypeCounters[V_SPELL_ALL]->insertSynCards(synergies);
-//    }
-//    else if(isSpellGen(code))                   cardTypeCounters[V_SPELL_ALL]->insertSynCards(synergies);
-    if(cardType == WEAPON)
+    if(synergiesCacheVersion != deckState.getVersion())
     {
-        cardTypeCounters[V_WEAPON]->insertSynCards(synergies);
-        cardTypeCounters[V_WEAPON_ALL]->insertSynCards(synergies);
+        synergiesCache.clear();
+        synergiesCacheVersion = deckState.getVersion();
     }
-    else if(isWeaponGen(code, text))            cardTypeCounters[V_WEAPON_ALL]->insertSynCards(synergies);
 
+    const QString code = deckCard.getCode();
+    QHash<QString, CardSynergies>::const_iterator it = synergiesCache.constFind(code);
+    if(it == synergiesCache.constEnd())
+    {
+        const CardCounterData &data = getCardCounterData(deckCard);
+        CardSynergies cardSynergies;
+        synergyMatcher.insertSynergies(SynergyMatcher::getFeatures(data), cardSynergies.synergies);
+        getDropMechanicIcons(data, cardSynergies.mechanicIcons, cardSynergies.dropBorderColor);
+        getMechanicIcons(data, cardSynergies.mechanicIcons);
+        getDirectLinkSynergies(deckCard, cardSynergies.synergies);
+        getStatsCardsSynergies(deckCard, cardSynergies.synergies);
+        it = synergiesCache.insert(code, cardSynergies);
+    }
 
-    if(isSpellSyn(code))                        cardTypeCounters[V_SPELL]->insertCards(synergies);
-    else if(isSpellAllSyn(code, text))          cardTypeCounters[V_SPELL_ALL]->insertCards(synergies);
-    if(isWeaponSyn(code))                       cardTypeCounters[V_WEAPON]->insertCards(synergies);
-    else if(isWeaponAllSyn(code, text))         cardTypeCounters[V_WEAPON_ALL]->insertCards(synergies);
+    synergies = it.value().synergies;
+    mechanicIcons = it.value().mechanicIcons;
+    dropBorderColor = it.value().dropBorderColor;
 }
 
 
-void SynergyHandler::getDropMechanicIcons(DeckCard &deckCard, QMap<QString, int> &mechanicIcons,
+void SynergyHandler::getDropMechanicIcons(const CardCounterData &data, QMap<QString, int> &mechanicIcons,
                                           MechanicBorderColor &dropBorderColor)
 {
-    QString code = deckCard.getCode();
-    int cost = deckCard.getCost();
-
-    if(isDrop2(code, cost))
-    {
-        mechanicIcons[ThemeHandler::drop2CounterFile()] = dropCounters[V_DROP2]->count() + 1;
-        dropBorderColor = dropCounters[V_DROP2]->getMechanicBorderColor();
-    }
-    else if(isDrop3(code, cost))
-    {
-        mechanicIcons[ThemeHandler::drop3CounterFile()] = dropCounters[V_DROP3]->count() + 1;
-        dropBorderColor = dropCounters[V_DROP3]->getMechanicBorderColor();
-    }
-    else if(isDrop4(code, cost))
-    {
-        mechanicIcons[ThemeHandler::drop4CounterFile()] = dropCounters[V_DROP4]->count() + 1;
-        dropBorderColor = dropCounters[V_DROP4]->getMechanicBorderColor();
-    }
-    else
+    if(data.drop == -1)
     {
         dropBorderColor = MechanicBorderGrey;
+        return;
     }
-}
-
-
-void SynergyHandler::getRaceSynergies(DeckCard &deckCard, QMap<QString,int> &synergies)
-{
-    QString code = deckCard.getCode();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardRace cardRace = deckCard.getRace();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-
-    if(cardRace == MURLOC)
-    {
-        raceCounters[V_MURLOC]->insertSynCards(synergies);
-        raceCounters[V_MURLOC_ALL]->insertSynCards(synergies);
-    }
-    else if(isMurlocGen(code))      raceCounters[V_MURLOC_ALL]->insertSynCards(synergies);
-    if(cardRace == DEMON)
-    {
-        raceCounters[V_DEMON]->insertSynCards(synergies);
-        raceCounters[V_DEMON_ALL]->insertSynCards(synergies);
-    }
-    else if(isDemonGen(code))       raceCounters[V_DEMON_ALL]->insertSynCards(synergies);
-    if(cardRace == MECHANICAL)
-    {
-        raceCounters[V_MECHANICAL]->insertSynCards(synergies);
-        raceCounters[V_MECHANICAL_ALL]->insertSynCards(synergies);
-    }
-    else if(isMechGen(code))        raceCounters[V_MECHANICAL_ALL]->insertSynCards(synergies);
-    if(cardRace == ELEMENTAL)
-    {
-        raceCounters[V_ELEMENTAL]->insertSynCards(synergies);
-        raceCounters[V_ELEMENTAL_ALL]->insertSynCards(synergies);
-    }
-    else if(isElementalGen(code))   raceCounters[V_ELEMENTAL_ALL]->insertSynCards(synergies);
-    if(cardRace == BEAST)
-    {
-        raceCounters[V_BEAST]->insertSynCards(synergies);
-        raceCounters[V_BEAST_ALL]->insertSynCards(synergies);
-    }
-    else if(isBeastGen(code))       raceCounters[V_BEAST_ALL]->insertSynCards(synergies);
-    if(cardRace == TOTEM)
-    {
-        raceCounters[V_TOTEM]->insertSynCards(synergies);
-        raceCounters[V_TOTEM_ALL]->insertSynCards(synergies);
-    }
-    else if(isTotemGen(code))       raceCounters[V_TOTEM_ALL]->insertSynCards(synergies);
-    if(cardRace == PIRATE)
-    {
-        raceCounters[V_PIRATE]->insertSynCards(synergies);
-        raceCounters[V_PIRATE_ALL]->insertSynCards(synergies);
-    }
-    else if(isPirateGen(code))      raceCounters[V_PIRATE_ALL]->insertSynCards(synergies);
-    if(cardRace == DRAGON)
-    {
-        raceCounters[V_DRAGON]->insertSynCards(synergies);
-        raceCounters[V_DRAGON_ALL]->insertSynCards(synergies);
-    }
-    else if(isDragonGen(code))      raceCounters[V_DRAGON_ALL]->insertSynCards(synergies);
 
-    if(isMurlocSyn(code))                           raceCounters[V_MURLOC]->insertCards(synergies);
-    else if(isMurlocAllSyn(code, text))             raceCounters[V_MURLOC_ALL]->insertCards(synergies);
-    if(isDemonSyn(code))                            raceCounters[V_DEMON]->insertCards(synergies);
-    else if(isDemonAllSyn(code, text))              raceCounters[V_DEMON_ALL]->insertCards(synergies);
-    if(isMechSyn(code))                             raceCounters[V_MECHANICAL]->insertCards(synergies);
-    else if(isMechAllSyn(code, mechanics, text))    raceCounters[V_MECHANICAL_ALL]->insertCards(synergies);
-    if(isElementalSyn(code))                        raceCounters[V_ELEMENTAL]->insertCards(synergies);
-    else if(isElementalAllSyn(code, text))          raceCounters[V_ELEMENTAL_ALL]->insertCards(synergies);
-    if(isBeastSyn(code))                            raceCounters[V_BEAST]->insertCards(synergies);
-    else if(isBeastAllSyn(code, text))              raceCounters[V_BEAST_ALL]->insertCards(synergies);
-    if(isTotemSyn(code))                            raceCounters[V_TOTEM]->insertCards(synergies);
-    else if(isTotemAllSyn(code, text))              raceCounters[V_TOTEM_ALL]->insertCards(synergies);
-    if(isPirateSyn(code))                           raceCounters[V_PIRATE]->insertCards(synergies);
-    else if(isPirateAllSyn(code, text))             raceCounters[V_PIRATE_ALL]->insertCards(synergies);
-    if(isDragonSyn(code, text))                     raceCounters[V_DRAGON]->insertCards(synergies);
-    else if(isDragonAllSyn(code))                   raceCounters[V_DRAGON_ALL]->insertCards(synergies);
+    QString dropFile;
+    if(data.drop == V_DROP2)        dropFile = ThemeHandler::drop2CounterFile();
+    else if(data.drop == V_DROP3)   dropFile = ThemeHandler::drop3CounterFile();
+    else                            dropFile = ThemeHandler::drop4CounterFile();
+    mechanicIcons[dropFile] = dropCounters[data.drop]->count() + 1;
+    dropBorderColor = dropCounters[data.drop]->getMechanicBorderColor();
 }
 
 
-void SynergyHandler::getMechanicSynergies(DeckCard &deckCard, QMap<QString,int> &synergies, QMap<QString, int> &mechanicIcons)
+void SynergyHandler::getMechanicIcons(const CardCounterData &data, QMap<QString, int> &mechanicIcons)
 {
-    QString code = deckCard.getCode();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
-    CardType cardType = deckCard.getType();
-    CardClass cardClass = deckCard.getCardClass();
-    int attack = Utility::getCardAttribute(code, "attack").toInt();
-    int cost = deckCard.getCost();
-    bool addRestoreIcon = false;
-
-    //GEN
-    if(isDiscoverDrawGen(code, cost, mechanics, referencedTags, text))
-    {
-        mechanicIcons[ThemeHandler::drawMechanicFile()] = mechanicCounters[V_DISCOVER_DRAW]->count() + 1;
-    }
-    if(isTaunt(code, mechanics))
-    {
-        mechanicCounters[V_TAUNT]->insertSynCards(synergies);
-        mechanicCounters[V_TAUNT_ALL]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
-    }
-    else if(isTauntGen(code, referencedTags))
-    {
-        mechanicCounters[V_TAUNT_ALL]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
-    }
-    if(isAoeGen(code, text))
-    {
-        mechanicCounters[V_AOE]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::aoeMechanicFile()] = mechanicCounters[V_AOE]->count() + 1;
-    }
-    if(isPingGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicCounters[V_PING]->insertSynCards(synergies);
-        mechanicIcons[ThemeHandler::pingMechanicFile()] = mechanicCounters[V_PING]->count() + 1;
-    }
-    if(isDamageMinionsGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicIcons[ThemeHandler::damageMechanicFile()] = mechanicCounters[V_DAMAGE]->count() + 1;
-    }
-    if(isDestroyGen(code, mechanics, text))
-    {
-        mechanicIcons[ThemeHandler::destroyMechanicFile()] = mechanicCounters[V_DESTROY]->count() + 1;
-    }
-    if(isReachGen(code, mechanics, referencedTags, text, cardType, attack))
-    {
-        mechanicIcons[ThemeHandler::reachMechanicFile()] = mechanicCounters[V_REACH]->count() + 1;
-    }
-    if(isArmorGen(code, text))
-    {
-        mechanicCounters[V_ARMOR]->insertSynCards(synergies);
-        addRestoreIcon = true;
-    }
-    if(isRestoreFriendlyHeroGen(code, mechanics, referencedTags, text))
-    {
-        mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->insertSynCards(synergies);
-        addRestoreIcon = true;
-    }
-    if(addRestoreIcon)
-    {
-        mechanicIcons[ThemeHandler::survivalMechanicFile()] = mechanicCounters[V_SURVIVABILITY]->count() + 1;
-    }
-    if(isRestoreTargetMinionGen(code, text))                    mechanicCounters[V_RESTORE_TARGET_MINION]->insertSynCards(synergies);
-    if(isRestoreFriendlyMinionGen(code, text))                  mechanicCounters[V_RESTORE_FRIENDLY_MINION]->insertSynCards(synergies);
-    if(isJadeGolemGen(code, mechanics, referencedTags))         mechanicCounters[V_JADE_GOLEM]->insertCards(synergies);//Sinergias gen-gen
-    if(isHeroPowerGen(code, text, cardClass))                   mechanicCounters[V_HERO_POWER]->insertCards(synergies);//Sinergias gen-gen
-    if(isDiscoverGen(code, mechanics, referencedTags))          mechanicCounters[V_DISCOVER]->insertSynCards(synergies);
-    if(isDrawGen(code, text))                                   mechanicCounters[V_DRAW]->insertSynCards(synergies);
-    if(isToYourHandGen(code, cost, mechanics, text))            mechanicCounters[V_TOYOURHAND]->insertSynCards(synergies);
-    if(isOverload(code))                                        mechanicCounters[V_OVERLOAD]->insertSynCards(synergies);
-    if(isFreezeEnemyGen(code, mechanics, referencedTags, text)) mechanicCounters[V_FREEZE_ENEMY]->insertSynCards(synergies);
-    if(isDiscardGen(code, text))                                mechanicCounters[V_DISCARD]->insertSynCards(synergies);
-    if(isDeathrattleMinion(code, mechanics, cardType))          mechanicCounters[V_DEATHRATTLE]->insertSynCards(synergies);
-    if(isDeathrattleGoodAll(code, mechanics, referencedTags, cardType)) mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->insertSynCards(synergies);
-    if(isSilenceOwnGen(code, mechanics, referencedTags))        mechanicCounters[V_SILENCE]->insertSynCards(synergies);
-    if(isTauntGiverGen(code))                                   mechanicCounters[V_TAUNT_GIVER]->insertSynCards(synergies);
-    if(isTokenGen(code, text))                                  mechanicCounters[V_TOKEN]->insertSynCards(synergies);
-    if(isTokenCardGen(code, cost, mechanics, text))             mechanicCounters[V_TOKEN_CARD]->insertSynCards(synergies);
-    if(isComboGen(code, mechanics))                             mechanicCounters[V_COMBO]->insertSynCards(synergies);
-    if(isWindfuryMinion(code, mechanics, cardType))             mechanicCounters[V_WINDFURY_MINION]->insertSynCards(synergies);
-    if(isAttackBuffGen(code, text))                             mechanicCounters[V_ATTACK_BUFF]->insertSynCards(synergies);
-    if(isHealthBuffGen(code, text))                             mechanicCounters[V_HEALTH_BUFF]->insertSynCards(synergies);
-    if(isReturnGen(code, text))                                 mechanicCounters[V_RETURN]->insertSynCards(synergies);
-    if(isStealthGen(code, mechanics))                           mechanicCounters[V_STEALTH]->insertSynCards(synergies);
-    if(isSpellDamageGen(code))                                  mechanicCounters[V_SPELL_DAMAGE]->insertSynCards(synergies);
-    if(isEvolveGen(code, text))                                 mechanicCounters[V_EVOLVE]->insertSynCards(synergies);
-    if(isSpawnEnemyGen(code, text))                             mechanicCounters[V_SPAWN_ENEMY]->insertSynCards(synergies);
-    if(isEnrageGen(code, mechanics))                            mechanicCounters[V_ENRAGED]->insertSynCards(synergies);
-    if(isEggGen(code, mechanics, attack, cardType))             mechanicCounters[V_EGG]->insertSynCards(synergies);
-    if(isDamageFriendlyHeroGen(code))                           mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->insertSynCards(synergies);
-    if(isHandBuffGen(code, text))                               mechanicCounters[V_HAND_BUFF]->insertSynCards(synergies);
-    if(isEnemyDrawGen(code, text))                              mechanicCounters[V_ENEMY_DRAW]->insertSynCards(synergies);
-    if(isHeroAttackGen(code, text))                             mechanicCounters[V_HERO_ATTACK]->insertSynCards(synergies);
-    if(isSpellBuffGen(code, text, mechanics, cardType))         mechanicCounters[V_SPELL_BUFF]->insertSynCards(synergies);
-    if(isOtherClassGen(code, text, cardClass))                  mechanicCounters[V_OTHER_CLASS]->insertSynCards(synergies);
-    if(isSilverHandGen(code, text, cardClass))                  mechanicCounters[V_SILVER_HAND]->insertSynCards(synergies);
-    if(isTreantGen(code, text, cardClass))                      mechanicCounters[V_TREANT]->insertSynCards(synergies);
-    if(isLackeyGen(code, text))                                 mechanicCounters[V_LACKEY]->insertSynCards(synergies);
-    //New Synergy Step 5
-    if(isDivineShield(code, mechanics))
-    {
-        mechanicCounters[V_DIVINE_SHIELD]->insertSynCards(synergies);
-        mechanicCounters[V_DIVINE_SHIELD_ALL]->insertSynCards(synergies);
-    }
-    else if(isDivineShieldGen(code, referencedTags))            mechanicCounters[V_DIVINE_SHIELD_ALL]->insertSynCards(synergies);
-
-    if(isSecret(code, mechanics))
-    {
-        mechanicCounters[V_SECRET]->insertSynCards(synergies);
-        mechanicCounters[V_SECRET_ALL]->insertSynCards(synergies);
-    }
-    else if(isSecretGen(code))                                  mechanicCounters[V_SECRET_ALL]->insertSynCards(synergies);
-    if(isEcho(code, mechanics))
-    {
-        mechanicCounters[V_ECHO]->insertSynCards(synergies);
-        mechanicCounters[V_ECHO_ALL]->insertSynCards(synergies);
-    }
-    else if(isEchoGen(code, referencedTags))                    mechanicCounters[V_ECHO_ALL]->insertSynCards(synergies);
-    if(isRush(code, mechanics))
-    {
-        mechanicCounters[V_RUSH]->insertSynCards(synergies);
-        mechanicCounters[V_RUSH_ALL]->insertSynCards(synergies);
-    }
-    else if(isRushGen(code, referencedTags))                    mechanicCounters[V_RUSH_ALL]->insertSynCards(synergies);
-    if(isMagnetic(code, mechanics))
-    {
-        mechanicCounters[V_MAGNETIC]->insertSynCards(synergies);
-        mechanicCounters[V_MAGNETIC_ALL]->insertSynCards(synergies);
-    }
-    else if(isMagneticGen(code))                                mechanicCounters[V_MAGNETIC_ALL]->insertSynCards(synergies);
-    if(isLifestealMinon(code, mechanics, cardType))
-    {
-        mechanicCounters[V_LIFESTEAL_MINION]->insertSynCards(synergies);
-        mechanicCounters[V_LIFESTEAL_ALL]->insertSynCards(synergies);
-    }
-    else if(isLifestealGen(code, referencedTags))               mechanicCounters[V_LIFESTEAL_ALL]->insertSynCards(synergies);
-    if(isBattlecry(code, mechanics))
-    {
-        mechanicCounters[V_BATTLECRY]->insertSynCards(synergies);
-        mechanicCounters[V_BATTLECRY_ALL]->insertSynCards(synergies);
-    }
-    else if(isBattlecryGen(code))                               mechanicCounters[V_BATTLECRY_ALL]->insertSynCards(synergies);
-
-
-    //SYN
-    if(isAoeSyn(code))                                          mechanicCounters[V_AOE]->insertCards(synergies);
-    if(isPingSyn(code))                                         mechanicCounters[V_PING]->insertCards(synergies);
-    if(isDiscoverSyn(code))                                     mechanicCounters[V_DISCOVER]->insertCards(synergies);
-    if(isDrawSyn(code))                                         mechanicCounters[V_DRAW]->insertCards(synergies);
-    if(isToYourHandSyn(code))                                   mechanicCounters[V_TOYOURHAND]->insertCards(synergies);
-    if(isOverloadSyn(code, text))                               mechanicCounters[V_OVERLOAD]->insertCards(synergies);
-    if(isFreezeEnemySyn(code, referencedTags, text))            mechanicCounters[V_FREEZE_ENEMY]->insertCards(synergies);
-    if(isDiscardSyn(code, text))                                mechanicCounters[V_DISCARD]->insertCards(synergies);
-    if(isSilenceOwnSyn(code, mechanics))                        mechanicCounters[V_SILENCE]->insertCards(synergies);
-    if(isTauntGiverSyn(code, mechanics, attack, cardType))      mechanicCounters[V_TAUNT_GIVER]->insertCards(synergies);
-    if(isTokenSyn(code, text))                                  mechanicCounters[V_TOKEN]->insertCards(synergies);
-    if(isTokenCardSyn(code, text))                              mechanicCounters[V_TOKEN_CARD]->insertCards(synergies);
-    if(isComboSyn(code, referencedTags))                        mechanicCounters[V_COMBO]->insertCards(synergies);
-    if(isWindfuryMinionSyn(code))                               mechanicCounters[V_WINDFURY_MINION]->insertCards(synergies);
-    if(isAttackBuffSyn(code, mechanics, attack, cardType))      mechanicCounters[V_ATTACK_BUFF]->insertCards(synergies);
-    if(isHealthBuffSyn(code))                                   mechanicCounters[V_HEALTH_BUFF]->insertCards(synergies);
-    //returnSyn es synergia debil
-//    if(isReturnSyn(code, mechanics, cardType, text))            mechanicCounters[V_RETURN]->insertCards(synergies);
-    if(isStealthSyn(code))                                      mechanicCounters[V_STEALTH]->insertCards(synergies);
-    if(isSpellDamageSyn(code, mechanics, cardType, text))       mechanicCounters[V_SPELL_DAMAGE]->insertCards(synergies);
-    if(isEvolveSyn(code))                                       mechanicCounters[V_EVOLVE]->insertCards(synergies);
-    if(isSpawnEnemySyn(code))                                   mechanicCounters[V_SPAWN_ENEMY]->insertCards(synergies);
-    if(isRestoreTargetMinionSyn(code))                          mechanicCounters[V_RESTORE_TARGET_MINION]->insertCards(synergies);
-    if(isRestoreFriendlyHeroSyn(code))                          mechanicCounters[V_RESTORE_FRIENDLY_HEROE]->insertCards(synergies);
-    if(isRestoreFriendlyMinionSyn(code))                        mechanicCounters[V_RESTORE_FRIENDLY_MINION]->insertCards(synergies);
-    if(isArmorSyn(code))                                        mechanicCounters[V_ARMOR]->insertCards(synergies);
-    if(isEnrageSyn(code, text))                                 mechanicCounters[V_ENRAGED]->insertCards(synergies);
-    if(isEggSyn(code, text))                                    mechanicCounters[V_EGG]->insertCards(synergies);
-    if(isDamageFriendlyHeroSyn(code))                           mechanicCounters[V_DAMAGE_FRIENDLY_HERO]->insertCards(synergies);
-    if(isHandBuffSyn(code, text))                               mechanicCounters[V_HAND_BUFF]->insertCards(synergies);
-    if(isEnemyDrawSyn(code, text))                              mechanicCounters[V_ENEMY_DRAW]->insertCards(synergies);
-    if(isHeroAttackSyn(code))                                   mechanicCounters[V_HERO_ATTACK]->insertCards(synergies);
-    if(isSpellBuffSyn(code, text))                              mechanicCounters[V_SPELL_BUFF]->insertCards(synergies);
-    if(isOtherClassSyn(code, text, cardClass))                  mechanicCounters[V_OTHER_CLASS]->insertCards(synergies);
-    if(isSilverHandSyn(code))                                   mechanicCounters[V_SILVER_HAND]->insertCards(synergies);
-    if(isTreantSyn(code))                                       mechanicCounters[V_TREANT]->insertCards(synergies);
-    if(isLackeySyn(code))                                       mechanicCounters[V_LACKEY]->insertCards(synergies);
-    //New Synergy Step 6
-    if(isTauntSyn(code))                                        mechanicCounters[V_TAUNT]->insertCards(synergies);
-    else if(isTauntAllSyn(code))                                mechanicCounters[V_TAUNT_ALL]->insertCards(synergies);
-    if(isDeathrattleSyn(code))                                  mechanicCounters[V_DEATHRATTLE]->insertCards(synergies);
-    else if(isDeathrattleGoodAllSyn(code))                      mechanicCounters[V_DEATHRATTLE_GOOD_ALL]->insertCards(synergies);
-    if(isDivineShieldSyn(code))                                 mechanicCounters[V_DIVINE_SHIELD]->insertCards(synergies);
-    else if(isDivineShieldAllSyn(code))                         mechanicCounters[V_DIVINE_SHIELD_ALL]->insertCards(synergies);
-    if(isSecretSyn(code))                                       mechanicCounters[V_SECRET]->insertCards(synergies);
-    else if(isSecretAllSyn(code, referencedTags))               mechanicCounters[V_SECRET_ALL]->insertCards(synergies);
-    if(isEchoSyn(code))                                         mechanicCounters[V_ECHO]->insertCards(synergies);
-    else if(isEchoAllSyn(code))                                 mechanicCounters[V_ECHO_ALL]->insertCards(synergies);
-    if(isRushSyn(code))                                         mechanicCounters[V_RUSH]->insertCards(synergies);
-    else if(isRushAllSyn(code))                                 mechanicCounters[V_RUSH_ALL]->insertCards(synergies);
-    if(isMagneticSyn(code))                                     mechanicCounters[V_MAGNETIC]->insertCards(synergies);
-    else if(isMagneticAllSyn(code))                             mechanicCounters[V_MAGNETIC_ALL]->insertCards(synergies);
-    if(isLifestealMinionSyn(code))                              mechanicCounters[V_LIFESTEAL_MINION]->insertCards(synergies);
-    else if(isLifestealAllSyn(code))                            mechanicCounters[V_LIFESTEAL_ALL]->insertCards(synergies);
-    if(isBattlecrySyn(code))                                    mechanicCounters[V_BATTLECRY]->insertCards(synergies);
-    else if(isBattlecryAllSyn(code, referencedTags))            mechanicCounters[V_BATTLECRY_ALL]->insertCards(synergies);
+    if(data.mechanicGen[V_DISCOVER_DRAW])   mechanicIcons[ThemeHandler::drawMechanicFile()] = mechanicCounters[V_DISCOVER_DRAW]->count() + 1;
+    if(data.mechanicGen[V_TAUNT_ALL])       mechanicIcons[ThemeHandler::tauntMechanicFile()] = mechanicCounters[V_TAUNT_ALL]->count() + 1;
+    if(data.mechanicGen[V_AOE])             mechanicIcons[ThemeHandler::aoeMechanicFile()] = mechanicCounters[V_AOE]->count() + 1;
+    if(data.mechanicGen[V_PING])            mechanicIcons[ThemeHandler::pingMechanicFile()] = mechanicCounters[V_PING]->count() + 1;
+    if(data.mechanicGen[V_DAMAGE])          mechanicIcons[ThemeHandler::damageMechanicFile()] = mechanicCounters[V_DAMAGE]->count() + 1;
+    if(data.mechanicGen[V_DESTROY])         mechanicIcons[ThemeHandler::destroyMechanicFile()] = mechanicCounters[V_DESTROY]->count() + 1;
+    if(data.mechanicGen[V_REACH])           mechanicIcons[ThemeHandler::reachMechanicFile()] = mechanicCounters[V_REACH]->count() + 1;
+    if(data.mechanicGen[V_SURVIVABILITY])   mechanicIcons[ThemeHandler::survivalMechanicFile()] = mechanicCounters[V_SURVIVABILITY]->count() + 1;
 }
 
 
@@ -1359,7 +1073,7 @@ void SynergyHandler::getStatsCardsSynergies(DeckCard &deckCard, QMap<QString,int
 //    }
 
     //Synergies
-    QList<StatSyn> statSyns = StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);
+    const QList<StatSyn> statSyns = synergyRules.value(code).statSyns;
     for(const StatSyn &statSyn: statSyns)
     {
         switch(statSyn.cardType)
@@ -1418,49 +1132,8 @@ void SynergyHandler::getStatsCardsSynergies(DeckCard &deckCard, QMap<QString,int
 bool SynergyHandler::isValidSynergyCode(const QString &mechanic)
 {
     if(mechanic.startsWith('='))    return true;
-    QStringList validMecs = {
-        "spellGen", "weaponGen", "murlocGen", "demonGen", "mechGen", "elementalGen", "beastGen", "totemGen", "pirateGen", "dragonGen",
-        "spellSyn", "weaponSyn", "murlocSyn", "demonSyn", "mechSyn", "elementalSyn", "beastSyn", "totemSyn", "pirateSyn", "dragonSyn",
-        "spellAllSyn", "weaponAllSyn", "murlocAllSyn", "demonAllSyn", "mechAllSyn", "elementalAllSyn", "beastAllSyn", "totemAllSyn", "pirateAllSyn", "dragonAllSyn",
-
-        "drop2", "drop3", "drop4",
-
-        "discover", "drawGen", "toYourHandGen", "enemyDrawGen",
-        "discoverSyn", "drawSyn", "toYourHandSyn", "enemyDrawSyn",
-
-        "taunt", "tauntGen", "divineShield", "divineShieldGen", "windfury", "overload",
-        "tauntSyn", "tauntAllSyn", "divineShieldSyn", "divineShieldAllSyn", "windfuryMinionSyn", "overloadSyn",
-
-        "jadeGolemGen", "secret", "secretGen", "freezeEnemyGen", "discardGen", "stealthGen",
-        "heroPowerGen", "secretSyn", "secretAllSyn", "freezeEnemySyn", "discardSyn", "stealthSyn",
-
-        "damageMinionsGen", "reachGen", "pingGen", "aoeGen", "destroyGen",
-        "damageMinionsSyn", "reachSyn", "pingSyn", "aoeSyn", "destroySyn",
-
-        "deathrattle", "deathrattleGen", "deathrattleOpponent", "silenceOwnGen", "battlecry", "battlecryGen", "returnGen",
-        "deathrattleSyn", "deathrattleGoodAllSyn", "silenceOwnSyn", "battlecrySyn", "battlecryAllSyn", "returnSyn",
-
-        "enrageGen", "tauntGiverGen", "evolveGen", "spawnEnemyGen", "spellDamageGen", "handBuffGen", "spellBuffGen",
-        "enrageSyn", "tauntGiverSyn", "evolveSyn", "spawnEnemySyn", "spellDamageSyn", "handBuffSyn", "spellBuffSyn",
-
-        "tokenGen", "tokenCardGen", "comboGen", "attackBuffGen", "healthBuffGen", "heroAttackGen",
-        "tokenSyn", "tokenCardSyn", "comboSyn", "attackBuffSyn", "healthBuffSyn", "heroAttackSyn",
-
-        "restoreTargetMinionGen", "restoreFriendlyHeroGen", "restoreFriendlyMinionGen",
-        "restoreTargetMinionSyn", "restoreFriendlyHeroSyn", "restoreFriendlyMinionSyn",
-
-        "armorGen", "lifesteal", "lifestealGen",
-        "armorSyn", "lifestealMinionSyn", "lifestealAllSyn",
-
-        "eggGen", "damageFriendlyHeroGen", "echo", "echoGen", "rush", "rushGen", "magnetic", "magneticGen",
-        "eggSyn", "damageFriendlyHeroSyn", "echoSyn", "echoAllSyn", "rushSyn", "rushAllSyn", "magneticSyn", "magneticAllSyn",
-
-        "otherClassGen", "silverHandGen", "treantGen", "lackeyGen",
-        "otherClassSyn", "silverHandSyn", "treantSyn", "lackeySyn"
-        //New Synergy Step 7
-    };
     if(mechanic.startsWith("discover") || mechanic.startsWith("drawGen") || mechanic.startsWith("toYourHandGen"))   return true;
-    return validMecs.contains(mechanic);
+    return CardSynergyRules::keyFromString(mechanic) != SK_NUM_KEYS;
 }
 
 
@@ -1486,17 +1159,17 @@ void SynergyHandler::testSynergies()
         DeckCard deckCard(code);
         CardType cardType = deckCard.getType();
         CardClass cardClass = deckCard.getCardClass();
-        QString text = Utility::cardEnTextFromCode(code).toLower();
+        QString text = Utility::getCardRuleData(code).text;
         int attack = Utility::getCardAttribute(code, "attack").toInt();
         int cost = deckCard.getCost();
-        QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-        QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
+        CardTags mechanics = Utility::getCardRuleData(code).mechanics;
+        CardTags referencedTags = Utility::getCardRuleData(code).referencedTags;
         if(
                 containsAll(text, "discover battlecry")
 //                && (cardClass == NEUTRAL || cardClass == PRIEST)
 //                && cardType == MINION
-//                && !mechanics.contains(QJsonValue("BATTLECRY"))
-//                && referencedTags.contains(QJsonValue("BATTLECRY"))
+//                && !mechanics.contains(TAG_BATTLECRY)
+//                && referencedTags.contains(TAG_BATTLECRY)
 //                isLackeyGen(code, text)
 
 
@@ -1570,7 +1243,7 @@ void SynergyHandler::debugMissingSynergiesAllSets()
     int num = 0;
     for(const QString &code: Utility::getWildCodes())
     {
-        if(!synergyCodes.contains(code))
+        if(!synergyRules.contains(code))
         {
             if(!code.startsWith("HERO_") && Utility::getCardAttribute(code, "set") != "WILD_EVENT")
             {
@@ -1580,12 +1253,12 @@ void SynergyHandler::debugMissingSynergiesAllSets()
         else
         {
             QStringList invalidMecs;
-            for(const QString &mechanic: synergyCodes[code])
+            //Los fallos en synergy stats (=GenMinionHealth1) se avisan al compilar las reglas en initSynergyCodes
+            for(const QString &mechanic: synergyRules[code].jsonKeys)
             {
                 if(!isValidSynergyCode(mechanic))   invalidMecs.append(mechanic);
             }
             if(!invalidMecs.isEmpty())  qDebug()<<"DEBUG SYNERGIES: Code:"<<code<<"No mecs:"<<invalidMecs;
-            StatSynergies::getStatsSynergiesFromJson(code, synergyCodes);//Check fallos en synergy stats -> =GenMinionHealth1
         }
     }
 
@@ -1609,12 +1282,12 @@ void SynergyHandler::debugSynergiesCode(const QString &code, int num)
     DeckCard deckCard(code);
     CardType cardType = deckCard.getType();
     CardClass cardClass = deckCard.getCardClass();
-    QString text = Utility::cardEnTextFromCode(code).toLower();
+    QString text = Utility::getCardRuleData(code).text;
     int attack = Utility::getCardAttribute(code, "attack").toInt();
     int health = Utility::getCardAttribute(code, "health").toInt();
     int cost = deckCard.getCost();
-    QJsonArray mechanics = Utility::getCardAttribute(code, "mechanics").toArray();
-    QJsonArray referencedTags = Utility::getCardAttribute(code, "referencedTags").toArray();
+    CardTags mechanics = Utility::getCardRuleData(code).mechanics;
+    CardTags referencedTags = Utility::getCardRuleData(code).referencedTags;
 
     if(isMurlocAllSyn(code, text))          mec<<"murlocAllSyn";
     if(isDemonAllSyn(code, text))           mec<<"demonAllSyn";
@@ -1710,7 +1383,7 @@ void SynergyHandler::debugSynergiesCode(const QString &code, int num)
     if(isOtherClassSyn(code, text, cardClass))                              mec<<"otherClassSyn";
     //New Synergy Step 9 (Solo si busca patron)
 
-    if(synergyCodes.contains(code)) qDebug()<<"--MANUAL-- :"<<code<<": ["<<synergyCodes[code]<<"],";
+    if(synergyRules.contains(code)) qDebug()<<"--MANUAL-- :"<<code<<": ["<<synergyRules[code].jsonKeys<<"],";
     else                            qDebug()<<code<<": ["<<mec<<"],";
     qDebug()<<"Texto:"<<text;
     qDebug()<<Utility::getCardAttribute(code, "type").toString()<<"--"<<cost<<"--"<<attack<<"/"<<health;
@@ -1723,15 +1396,15 @@ void SynergyHandler::debugSynergiesCode(const QString &code, int num)
 //Increase counters
 bool SynergyHandler::isSpellGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("spellGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_SPELL_GEN);
     return false;
 }
 bool SynergyHandler::isWeaponGen(const QString &code, const QString &text)
 {
     //NO TEST
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("weaponGen");
+        return synergyRules[code].contains(SK_WEAPON_GEN);
     }
     else if(text.contains("equip "))
     {
@@ -1741,45 +1414,45 @@ bool SynergyHandler::isWeaponGen(const QString &code, const QString &text)
 }
 bool SynergyHandler::isMurlocGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("murlocGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_MURLOC_GEN);
     return false;
 }
 bool SynergyHandler::isDemonGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("demonGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_DEMON_GEN);
     return false;
 }
 bool SynergyHandler::isMechGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("mechGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_MECH_GEN);
     return false;
 }
 bool SynergyHandler::isElementalGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("elementalGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_ELEMENTAL_GEN);
     return false;
 }
 bool SynergyHandler::isBeastGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("beastGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_BEAST_GEN);
     return false;
 }
 bool SynergyHandler::isTotemGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("totemGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_TOTEM_GEN);
     return false;
 }
 bool SynergyHandler::isPirateGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("pirateGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_PIRATE_GEN);
     return false;
 }
 bool SynergyHandler::isDragonGen(const QString &code)
 {
-    if(synergyCodes.contains(code)) return synergyCodes[code].contains("dragonGen");
+    if(synergyRules.contains(code)) return synergyRules[code].contains(SK_DRAGON_GEN);
     return false;
 }
-bool SynergyHandler::isDiscoverDrawGen(const QString &code, int cost, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isDiscoverDrawGen(const QString &code, int cost, const CardTags &mechanics, const CardTags &referencedTags,
                                        const QString &text)
 {
     //TEST
@@ -1788,28 +1461,19 @@ bool SynergyHandler::isDiscoverDrawGen(const QString &code, int cost, const QJso
             isDrawGen(code, text) ||
             isToYourHandGen(code, cost, mechanics, text));
 }
-bool SynergyHandler::isDiscoverGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags)
+bool SynergyHandler::isDiscoverGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags)
 {
     return numDiscoverGen(code, mechanics, referencedTags)>0;
 }
-int SynergyHandler::numDiscoverGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags)
+int SynergyHandler::numDiscoverGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags)
 {
     //TEST
     //&& text.contains("discover")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        for(QString mechanic: synergyCodes[code])
-        {
-            if(mechanic.startsWith("discover"))
-            {
-                mechanic.remove(0,8);
-                if(!mechanic.isEmpty())     return mechanic.toInt();
-                return 1;
-            }
-        }
-        return 0;
+        return qMax(0, synergyRules[code].discover);
     }
-    else if(mechanics.contains(QJsonValue("DISCOVER")) || referencedTags.contains(QJsonValue("DISCOVER")))
+    else if(mechanics.contains(TAG_DISCOVER) || referencedTags.contains(TAG_DISCOVER))
     {
         return 1;
     }
@@ -1823,18 +1487,9 @@ int SynergyHandler::numDrawGen(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("draw")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        for(QString mechanic: synergyCodes[code])
-        {
-            if(mechanic.startsWith("drawGen"))
-            {
-                mechanic.remove(0,7);
-                if(!mechanic.isEmpty())     return mechanic.toInt();
-                return 1;
-            }
-        }
-        return 0;
+        return qMax(0, synergyRules[code].draw);
     }
     else if(text.contains("draw") && !text.contains("drawn"))
     {
@@ -1842,55 +1497,48 @@ int SynergyHandler::numDrawGen(const QString &code, const QString &text)
     }
     return 0;
 }
-bool SynergyHandler::isToYourHandGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text)
+bool SynergyHandler::isToYourHandGen(const QString &code, int cost, const CardTags &mechanics, const QString &text)
 {
     return numToYourHandGen(code, cost, mechanics, text)>0;
 }
-int SynergyHandler::numToYourHandGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text)
+int SynergyHandler::numToYourHandGen(const QString &code, int cost, const CardTags &mechanics, const QString &text)
 {
     //TEST
     //&& (text.contains("to") && text.contains("your") && text.contains("hand"))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        for(QString mechanic: synergyCodes[code])
-        {
-            if(mechanic.startsWith("toYourHandGen"))
-            {
-                mechanic.remove(0,13);
-                if(!mechanic.isEmpty())     return mechanic.toInt();
-                return 1;
-            }
-        }
-        if(synergyCodes[code].contains("echo")) return 1;
+        const CardSynergyRules &rules = synergyRules[code];
+        if(rules.toYourHand >= 0)       return rules.toYourHand;
+        if(rules.contains(SK_ECHO))     return 1;
         return 0;
     }
     else if(isEcho(code, mechanics))                                    return 1;
-    else if(cost > 1 && mechanics.contains(QJsonValue("TWINSPELL")))    return 1;
+    else if(cost > 1 && mechanics.contains(TAG_TWINSPELL))    return 1;
     else if(text.contains("to") && text.contains("your") && text.contains("hand") && !text.contains("return"))
     {
         return 1;
     }
     return 0;
 }
-bool SynergyHandler::isTaunt(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isTaunt(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("taunt");
+        return synergyRules[code].contains(SK_TAUNT);
     }
-    else if(mechanics.contains(QJsonValue("TAUNT")))
+    else if(mechanics.contains(TAG_TAUNT))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isTauntGen(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isTauntGen(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tauntGen") || synergyCodes[code].contains("tauntGiverGen");
+        return synergyRules[code].contains(SK_TAUNT_GEN) || synergyRules[code].contains(SK_TAUNT_GIVER_GEN);
     }
-    else if(referencedTags.contains(QJsonValue("TAUNT")))
+    else if(referencedTags.contains(TAG_TAUNT))
     {
         return true;
     }
@@ -1898,9 +1546,9 @@ bool SynergyHandler::isTauntGen(const QString &code, const QJsonArray &reference
 }
 bool SynergyHandler::isAoeGen(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("aoeGen");
+        return synergyRules[code].contains(SK_AOE_GEN);
     }
     else
     {
@@ -1911,25 +1559,25 @@ bool SynergyHandler::isAoeGen(const QString &code, const QString &text)
     }
 }
 //El ping debe poder seleccionar a un enemigo
-bool SynergyHandler::isPingGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isPingGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                              const QString &text, const CardType &cardType, int attack)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("pingGen");
+        return synergyRules[code].contains(SK_PING_GEN);
     }
     //Anything that deals damage
     else if(text.contains("deal") && text.contains("1 damage") &&
             !text.contains("hero"))
     {
-        if(mechanics.contains("DEATHRATTLE") && text.contains("random"))    return false;
+        if(mechanics.contains(TAG_DEATHRATTLE) && text.contains("random"))    return false;
         else return true;
     }
     else if(attack != 1)  return false;
     //Charge minions
     else if(cardType == MINION)
     {
-        if(mechanics.contains(QJsonValue("CHARGE")) || referencedTags.contains(QJsonValue("CHARGE")))
+        if(mechanics.contains(TAG_CHARGE) || referencedTags.contains(TAG_CHARGE))
         {
             return !text.contains("gain <b>charge</b>");
         }
@@ -1939,12 +1587,12 @@ bool SynergyHandler::isPingGen(const QString &code, const QJsonArray &mechanics,
     else if(cardType == WEAPON) return true;
     return false;
 }
-bool SynergyHandler::isReachGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isReachGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                               const QString &text, const CardType &cardType, int attack)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("reachGen");
+        return synergyRules[code].contains(SK_REACH_GEN);
     }
     //Anything that deals damage (no pings)
     else if(text.contains("damage") && text.contains("deal") &&
@@ -1963,8 +1611,8 @@ bool SynergyHandler::isReachGen(const QString &code, const QJsonArray &mechanics
     //Charge and stealth minions
     else if(cardType == MINION)
     {
-        if(mechanics.contains(QJsonValue("CHARGE")) || referencedTags.contains(QJsonValue("CHARGE")) ||
-            mechanics.contains(QJsonValue("STEALTH")) || referencedTags.contains(QJsonValue("STEALTH")))
+        if(mechanics.contains(TAG_CHARGE) || referencedTags.contains(TAG_CHARGE) ||
+            mechanics.contains(TAG_STEALTH) || referencedTags.contains(TAG_STEALTH))
         {
             return !text.contains("gain <b>charge</b>") && !text.contains("can't attack heroes");
         }
@@ -1973,21 +1621,21 @@ bool SynergyHandler::isReachGen(const QString &code, const QJsonArray &mechanics
     else if(cardType == WEAPON) return true;
     return false;
 }
-bool SynergyHandler::isDamageMinionsGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isDamageMinionsGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                                       const QString &text, const CardType &cardType, int attack)
 {
     //TEST
 //    (text.contains("damage") && text.contains("deal") &&
 //                !text.contains("1 damage") && !text.contains("all") && !text.contains("hero")) &&
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("damageMinionsGen");
+        return synergyRules[code].contains(SK_DAMAGE_MINIONS_GEN);
     }
     //Anything that deals damage (no pings)
     else if(text.contains("damage") && text.contains("deal") &&
             !text.contains("1 damage") && !text.contains("all") && !text.contains("hero"))
     {
-        if(mechanics.contains("DEATHRATTLE") && text.contains("random"))    return false;
+        if(mechanics.contains(TAG_DEATHRATTLE) && text.contains("random"))    return false;
         else return true;
     }
     //Hero attack
@@ -2000,7 +1648,7 @@ bool SynergyHandler::isDamageMinionsGen(const QString &code, const QJsonArray &m
     //Charge minions
     else if(cardType == MINION)
     {
-        if(mechanics.contains(QJsonValue("CHARGE")) || referencedTags.contains(QJsonValue("CHARGE")))
+        if(mechanics.contains(TAG_CHARGE) || referencedTags.contains(TAG_CHARGE))
         {
             return !text.contains("gain <b>charge</b>");
         }
@@ -2010,29 +1658,29 @@ bool SynergyHandler::isDamageMinionsGen(const QString &code, const QJsonArray &m
     else if(cardType == WEAPON) return true;
     return false;
 }
-bool SynergyHandler::isDestroyGen(const QString &code, const QJsonArray &mechanics, const QString &text)
+bool SynergyHandler::isDestroyGen(const QString &code, const CardTags &mechanics, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("destroyGen");
+        return synergyRules[code].contains(SK_DESTROY_GEN);
     }
     else if(text.contains("destroy") && text.contains("minion") &&
             !text.contains("all"))
     {
-        if(mechanics.contains("DEATHRATTLE") && text.contains("random"))    return false;
+        if(mechanics.contains(TAG_DEATHRATTLE) && text.contains("random"))    return false;
         else return true;
     }
     return false;
 }
-bool SynergyHandler::isEnrageGen(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isEnrageGen(const QString &code, const CardTags &mechanics)
 {
     //TEST
     //text.contains("takes") && text.contains("damage")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("enrageGen");
+        return synergyRules[code].contains(SK_ENRAGE_GEN);
     }
-    else if(mechanics.contains(QJsonValue("ENRAGED")))
+    else if(mechanics.contains(TAG_ENRAGED))
     {
         return true;
     }
@@ -2040,9 +1688,9 @@ bool SynergyHandler::isEnrageGen(const QString &code, const QJsonArray &mechanic
 }
 bool SynergyHandler::isOverload(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("overload");
+        return synergyRules[code].contains(SK_OVERLOAD);
     }
     else
     {
@@ -2050,13 +1698,13 @@ bool SynergyHandler::isOverload(const QString &code)
         return overload > 0;
     }
 }
-bool SynergyHandler::isJadeGolemGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags)
+bool SynergyHandler::isJadeGolemGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("jadeGolemGen");
+        return synergyRules[code].contains(SK_JADE_GOLEM_GEN);
     }
-    else if(mechanics.contains(QJsonValue("JADE_GOLEM")) || referencedTags.contains(QJsonValue("JADE_GOLEM")))
+    else if(mechanics.contains(TAG_JADE_GOLEM) || referencedTags.contains(TAG_JADE_GOLEM))
     {
         return true;
     }
@@ -2066,9 +1714,9 @@ bool SynergyHandler::isHeroPowerGen(const QString &code, const QString &text, co
 {
     //TEST
     //text.contains("hero power") || (text.contains("heal") && text.contains("deal damage") && cardClass == PRIEST)
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("heroPowerGen");
+        return synergyRules[code].contains(SK_HERO_POWER_GEN);
     }
     else if(text.contains("hero power") || (text.contains("heal") && text.contains("deal damage") && cardClass == PRIEST))
     {
@@ -2076,13 +1724,13 @@ bool SynergyHandler::isHeroPowerGen(const QString &code, const QString &text, co
     }
     return false;
 }
-bool SynergyHandler::isSecret(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isSecret(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("secret");
+        return synergyRules[code].contains(SK_SECRET);
     }
-    else if(mechanics.contains(QJsonValue("SECRET")))
+    else if(mechanics.contains(TAG_SECRET))
     {
         return true;
     }
@@ -2090,67 +1738,67 @@ bool SynergyHandler::isSecret(const QString &code, const QJsonArray &mechanics)
 }
 bool SynergyHandler::isSecretGen(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("secretGen");
+        return synergyRules[code].contains(SK_SECRET_GEN);
     }
     return false;
 }
-bool SynergyHandler::isEcho(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isEcho(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("echo");
+        return synergyRules[code].contains(SK_ECHO);
     }
-    else if(mechanics.contains(QJsonValue("ECHO")))
+    else if(mechanics.contains(TAG_ECHO))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isEchoGen(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isEchoGen(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("echoGen");
+        return synergyRules[code].contains(SK_ECHO_GEN);
     }
-    else if(referencedTags.contains(QJsonValue("ECHO")))
+    else if(referencedTags.contains(TAG_ECHO))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isRush(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isRush(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("rush");
+        return synergyRules[code].contains(SK_RUSH);
     }
-    else if(mechanics.contains(QJsonValue("RUSH")))
+    else if(mechanics.contains(TAG_RUSH))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isRushGen(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isRushGen(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("rushGen");
+        return synergyRules[code].contains(SK_RUSH_GEN);
     }
-    else if(referencedTags.contains(QJsonValue("RUSH")))
+    else if(referencedTags.contains(TAG_RUSH))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isMagnetic(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isMagnetic(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("magnetic");
+        return synergyRules[code].contains(SK_MAGNETIC);
     }
-    else if(mechanics.contains(QJsonValue("MODULAR")))
+    else if(mechanics.contains(TAG_MODULAR))
     {
         return true;
     }
@@ -2158,19 +1806,19 @@ bool SynergyHandler::isMagnetic(const QString &code, const QJsonArray &mechanics
 }
 bool SynergyHandler::isMagneticGen(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("magneticGen");
+        return synergyRules[code].contains(SK_MAGNETIC_GEN);
     }
     return false;
 }
-bool SynergyHandler::isEggGen(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType)
+bool SynergyHandler::isEggGen(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("eggGen");
+        return synergyRules[code].contains(SK_EGG_GEN);
     }
-    else if(cardType == MINION && attack == 0 && mechanics.contains(QJsonValue("DEATHRATTLE")) && !mechanics.contains(QJsonValue("TAUNT")))
+    else if(cardType == MINION && attack == 0 && mechanics.contains(TAG_DEATHRATTLE) && !mechanics.contains(TAG_TAUNT))
     {
         return true;
     }
@@ -2178,24 +1826,24 @@ bool SynergyHandler::isEggGen(const QString &code, const QJsonArray &mechanics,
 }
 bool SynergyHandler::isDamageFriendlyHeroGen(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("damageFriendlyHeroGen");
+        return synergyRules[code].contains(SK_DAMAGE_FRIENDLY_HERO_GEN);
     }
     return false;
 }
-bool SynergyHandler::isFreezeEnemyGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isFreezeEnemyGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                                  const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("freezeEnemyGen");
+        return synergyRules[code].contains(SK_FREEZE_ENEMY_GEN);
     }
-    else if(mechanics.contains(QJsonValue("FREEZE")))
+    else if(mechanics.contains(TAG_FREEZE))
     {
         return true;
     }
-    else if(referencedTags.contains(QJsonValue("FREEZE")))
+    else if(referencedTags.contains(TAG_FREEZE))
     {
         return !text.contains("frozen");
     }
@@ -2203,9 +1851,9 @@ bool SynergyHandler::isFreezeEnemyGen(const QString &code, const QJsonArray &mec
 }
 bool SynergyHandler::isDiscardGen(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("discardGen");
+        return synergyRules[code].contains(SK_DISCARD_GEN);
     }
     else if(text.contains("discard") && text.contains("random card"))
     {
@@ -2213,44 +1861,44 @@ bool SynergyHandler::isDiscardGen(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isDeathrattleMinion(const QString &code, const QJsonArray &mechanics, const CardType &cardType)
+bool SynergyHandler::isDeathrattleMinion(const QString &code, const CardTags &mechanics, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("deathrattle") || synergyCodes[code].contains("deathrattleOpponent");
+        return synergyRules[code].contains(SK_DEATHRATTLE) || synergyRules[code].contains(SK_DEATHRATTLE_OPPONENT);
     }
     else if(cardType != MINION)  return false;
-    else if(mechanics.contains(QJsonValue("DEATHRATTLE")))
+    else if(mechanics.contains(TAG_DEATHRATTLE))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isDeathrattleGoodAll(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+bool SynergyHandler::isDeathrattleGoodAll(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                                           const CardType &cardType)
 {
     //TEST
-    //&& (mechanics.contains(QJsonValue("DEATHRATTLE")) || referencedTags.contains(QJsonValue("DEATHRATTLE")))
-    if(synergyCodes.contains(code))
+    //&& (mechanics.contains(TAG_DEATHRATTLE) || referencedTags.contains(TAG_DEATHRATTLE))
+    if(synergyRules.contains(code))
     {
-        return (synergyCodes[code].contains("deathrattle") || synergyCodes[code].contains("deathrattleGen")) &&
-                !synergyCodes[code].contains("silenceOwnSyn") &&
-                !synergyCodes[code].contains("deathrattleOpponent");
+        return (synergyRules[code].contains(SK_DEATHRATTLE) || synergyRules[code].contains(SK_DEATHRATTLE_GEN)) &&
+                !synergyRules[code].contains(SK_SILENCE_OWN_SYN) &&
+                !synergyRules[code].contains(SK_DEATHRATTLE_OPPONENT);
     }
     else if(cardType != MINION)  return false;
-    else if(mechanics.contains(QJsonValue("DEATHRATTLE")) || referencedTags.contains(QJsonValue("DEATHRATTLE")))
+    else if(mechanics.contains(TAG_DEATHRATTLE) || referencedTags.contains(TAG_DEATHRATTLE))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isBattlecry(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isBattlecry(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("battlecry");
+        return synergyRules[code].contains(SK_BATTLECRY);
     }
-    else if(mechanics.contains(QJsonValue("BATTLECRY")))
+    else if(mechanics.contains(TAG_BATTLECRY))
     {
         return true;
     }
@@ -2258,23 +1906,23 @@ bool SynergyHandler::isBattlecry(const QString &code, const QJsonArray &mechanic
 }
 bool SynergyHandler::isBattlecryGen(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("battlecryGen");
+        return synergyRules[code].contains(SK_BATTLECRY_GEN);
     }
     return false;
 }
-bool SynergyHandler::isSilenceOwnGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags)
+bool SynergyHandler::isSilenceOwnGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("silenceOwnGen");
+        return synergyRules[code].contains(SK_SILENCE_OWN_GEN);
     }
-    else if(mechanics.contains(QJsonValue("SILENCE")))
+    else if(mechanics.contains(TAG_SILENCE))
     {
         return true;
     }
-    else if(referencedTags.contains(QJsonValue("SILENCE")))
+    else if(referencedTags.contains(TAG_SILENCE))
     {
         return true;
     }
@@ -2282,9 +1930,9 @@ bool SynergyHandler::isSilenceOwnGen(const QString &code, const QJsonArray &mech
 }
 bool SynergyHandler::isTauntGiverGen(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tauntGiverGen");
+        return synergyRules[code].contains(SK_TAUNT_GIVER_GEN);
     }
     return false;
 }
@@ -2292,9 +1940,9 @@ bool SynergyHandler::isTokenGen(const QString &code, const QString &text)
 {
     //TEST
     //(text.contains("1/1") || text.contains("2/1") || text.contains("1/2") || text.contains("2/2")) && !text.contains("opponent")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tokenGen");
+        return synergyRules[code].contains(SK_TOKEN_GEN);
     }
     else if((text.contains("1/1") || text.contains("2/1") || text.contains("1/2") || text.contains("0/2") || text.contains("0/1"))
             && text.contains("summon") && !text.contains("opponent"))
@@ -2303,38 +1951,38 @@ bool SynergyHandler::isTokenGen(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isTokenCardGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text)
+bool SynergyHandler::isTokenCardGen(const QString &code, int cost, const CardTags &mechanics, const QString &text)
 {
     //Incluimos cartas que en conjunto permitan jugar 2+ cartas de coste 0/1/2
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tokenCardGen") || synergyCodes[code].contains("lackeyGen");
+        return synergyRules[code].contains(SK_TOKEN_CARD_GEN) || synergyRules[code].contains(SK_LACKEY_GEN);
     }
     else if(cost == 0)                                                  return true;
-    else if(cost == 1 && mechanics.contains(QJsonValue("TWINSPELL")))   return true;
+    else if(cost == 1 && mechanics.contains(TAG_TWINSPELL))   return true;
     else if(text.contains("lackey"))                                    return true;
     return false;
 }
-bool SynergyHandler::isComboGen(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isComboGen(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("comboGen");
+        return synergyRules[code].contains(SK_COMBO_GEN);
     }
-    else if(mechanics.contains(QJsonValue("COMBO")))
+    else if(mechanics.contains(TAG_COMBO))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isWindfuryMinion(const QString &code, const QJsonArray &mechanics, const CardType &cardType)
+bool SynergyHandler::isWindfuryMinion(const QString &code, const CardTags &mechanics, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("windfury");
+        return synergyRules[code].contains(SK_WINDFURY);
     }
     else if(cardType != MINION)  return false;
-    else if(mechanics.contains(QJsonValue("WINDFURY")))
+    else if(mechanics.contains(TAG_WINDFURY))
     {
         return true;
     }
@@ -2346,9 +1994,9 @@ bool SynergyHandler::isAttackBuffGen(const QString &code, const QString &text)
 //    && (text.contains("+")
 //    && (text.contains("minion") || text.contains("character"))
 //    && (text.contains("attack") || text.contains("/+")))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("attackBuffGen");
+        return synergyRules[code].contains(SK_ATTACK_BUFF_GEN);
     }
     else if(text.contains("+")
             && (text.contains("give") || text.contains("have"))
@@ -2366,9 +2014,9 @@ bool SynergyHandler::isHealthBuffGen(const QString &code, const QString &text)
 //    && (text.contains("+")
 //    && (text.contains("minion") || text.contains("character"))
 //    && (text.contains("health") || text.contains("/+")))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("healthBuffGen");
+        return synergyRules[code].contains(SK_HEALTH_BUFF_GEN);
     }
     else if(text.contains("+")
             && (text.contains("give") || text.contains("have"))
@@ -2384,9 +2032,9 @@ bool SynergyHandler::isReturnGen(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("return a friendly minion")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("returnGen");
+        return synergyRules[code].contains(SK_RETURN_GEN);
     }
     else if(text.contains("return a friendly minion"))
     {
@@ -2394,43 +2042,43 @@ bool SynergyHandler::isReturnGen(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isStealthGen(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isStealthGen(const QString &code, const CardTags &mechanics)
 {
     //TEST
-    //&& (mechanics.contains(QJsonValue("STEALTH")) ||  referencedTags.contains(QJsonValue("STEALTH")))
-    if(synergyCodes.contains(code))
+    //&& (mechanics.contains(TAG_STEALTH) ||  referencedTags.contains(TAG_STEALTH))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("stealthGen");
+        return synergyRules[code].contains(SK_STEALTH_GEN);
     }
-    else if(mechanics.contains(QJsonValue("STEALTH")))
+    else if(mechanics.contains(TAG_STEALTH))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isDivineShield(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isDivineShield(const QString &code, const CardTags &mechanics)
 {
     //TEST
-    //&& (mechanics.contains(QJsonValue("DIVINE_SHIELD")) ||  referencedTags.contains(QJsonValue("DIVINE_SHIELD")))
-    if(synergyCodes.contains(code))
+    //&& (mechanics.contains(TAG_DIVINE_SHIELD) ||  referencedTags.contains(TAG_DIVINE_SHIELD))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("divineShield");
+        return synergyRules[code].contains(SK_DIVINE_SHIELD);
     }
-    else if(mechanics.contains(QJsonValue("DIVINE_SHIELD")))
+    else if(mechanics.contains(TAG_DIVINE_SHIELD))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isDivineShieldGen(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isDivineShieldGen(const QString &code, const CardTags &referencedTags)
 {
     //TEST
-    //&& (mechanics.contains(QJsonValue("DIVINE_SHIELD")) ||  referencedTags.contains(QJsonValue("DIVINE_SHIELD")))
-    if(synergyCodes.contains(code))
+    //&& (mechanics.contains(TAG_DIVINE_SHIELD) ||  referencedTags.contains(TAG_DIVINE_SHIELD))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("divineShieldGen");
+        return synergyRules[code].contains(SK_DIVINE_SHIELD_GEN);
     }
-    else if(referencedTags.contains(QJsonValue("DIVINE_SHIELD")))
+    else if(referencedTags.contains(TAG_DIVINE_SHIELD))
     {
         return true;
     }
@@ -2440,9 +2088,9 @@ bool SynergyHandler::isRestoreTargetMinionGen(const QString &code, const QString
 {
     //TEST
     //&& text.contains("restore") // No hace falta "heal", restore lo cubre todo excepto Prophet Velen y Wickerflame Burnbristle
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreTargetMinionGen");
+        return synergyRules[code].contains(SK_RESTORE_TARGET_MINION_GEN);
     }
     else if(text.contains("restore") && !text.contains("friendly") && !text.contains("hero"))
     {
@@ -2450,16 +2098,16 @@ bool SynergyHandler::isRestoreTargetMinionGen(const QString &code, const QString
     }
     return false;
 }
-bool SynergyHandler::isRestoreFriendlyHeroGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text)
+bool SynergyHandler::isRestoreFriendlyHeroGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const QString &text)
 {
     //TEST
     //&& text.contains("restore")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreFriendlyHeroGen") || synergyCodes[code].contains("lifesteal")
-                || synergyCodes[code].contains("lifestealGen");
+        return synergyRules[code].contains(SK_RESTORE_FRIENDLY_HERO_GEN) || synergyRules[code].contains(SK_LIFESTEAL)
+                || synergyRules[code].contains(SK_LIFESTEAL_GEN);
     }
-    else if(mechanics.contains(QJsonValue("LIFESTEAL")) || referencedTags.contains(QJsonValue("LIFESTEAL")))
+    else if(mechanics.contains(TAG_LIFESTEAL) || referencedTags.contains(TAG_LIFESTEAL))
     {
         return true;
     }
@@ -2473,9 +2121,9 @@ bool SynergyHandler::isRestoreFriendlyMinionGen(const QString &code, const QStri
 {
     //TEST
     //&& text.contains("restore")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreFriendlyMinionGen");
+        return synergyRules[code].contains(SK_RESTORE_FRIENDLY_MINION_GEN);
     }
     else if(text.contains("restore") && text.contains("friendly") && !text.contains("hero"))
     {
@@ -2487,9 +2135,9 @@ bool SynergyHandler::isArmorGen(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("armor")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("armorGen");
+        return synergyRules[code].contains(SK_ARMOR_GEN);
     }
     else if(text.contains("armor"))
     {
@@ -2497,26 +2145,26 @@ bool SynergyHandler::isArmorGen(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isLifestealMinon(const QString &code, const QJsonArray &mechanics, const CardType &cardType)
+bool SynergyHandler::isLifestealMinon(const QString &code, const CardTags &mechanics, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lifesteal");
+        return synergyRules[code].contains(SK_LIFESTEAL);
     }
     else if(cardType != MINION)  return false;
-    else if(mechanics.contains(QJsonValue("LIFESTEAL")))
+    else if(mechanics.contains(TAG_LIFESTEAL))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isLifestealGen(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isLifestealGen(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lifestealGen");
+        return synergyRules[code].contains(SK_LIFESTEAL_GEN);
     }
-    else if(referencedTags.contains(QJsonValue("LIFESTEAL")))
+    else if(referencedTags.contains(TAG_LIFESTEAL))
     {
         return true;
     }
@@ -2526,9 +2174,9 @@ bool SynergyHandler::isSpellDamageGen(const QString &code)
 {
     //TEST
     //&& text.contains("spell") && text.contains("damage")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellDamageGen");
+        return synergyRules[code].contains(SK_SPELL_DAMAGE_GEN);
     }
     else
     {
@@ -2540,9 +2188,9 @@ bool SynergyHandler::isEvolveGen(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("transform") && text.contains("cost") && text.contains("more")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("evolveGen");
+        return synergyRules[code].contains(SK_EVOLVE_GEN);
     }
     else if(text.contains("transform") && text.contains("cost") && text.contains("more"))
     {
@@ -2555,9 +2203,9 @@ bool SynergyHandler::isSpawnEnemyGen(const QString &code, const QString &text)
     //TEST
     //&& text.contains("summon") && text.contains("for") && text.contains("your") && text.contains("opponent")
     //Lo he abreviado pq algunos casos se escaban.
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spawnEnemyGen");
+        return synergyRules[code].contains(SK_SPAWN_ENEMY_GEN);
     }
     else if(text.contains("summon") && text.contains("opponent"))
     {
@@ -2569,9 +2217,9 @@ bool SynergyHandler::isHandBuffGen(const QString &code, const QString &text)
 {
     //TEST
     //(text.contains("give") && text.contains("in your hand"))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("handBuffGen");
+        return synergyRules[code].contains(SK_HAND_BUFF_GEN);
     }
     else if(text.contains("give") && text.contains("in your hand"))
     {
@@ -2583,9 +2231,9 @@ bool SynergyHandler::isEnemyDrawGen(const QString &code, const QString &text)
 {
     //TEST
     //(text.contains("both players") || text.contains("each player") || text.contains("your opponent") || text.contains("your enemy")) && text.contains("draw") && !text.contains("when drawn")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("enemyDrawGen");
+        return synergyRules[code].contains(SK_ENEMY_DRAW_GEN);
     }
     else if((text.contains("both players") || text.contains("each player") || text.contains("your opponent") || text.contains("your enemy")) &&
             text.contains("draw") && !text.contains("when drawn"))
@@ -2598,9 +2246,9 @@ bool SynergyHandler::isHeroAttackGen(const QString &code, const QString &text)
 {
     //TEST
     //(text.contains("hero") || text.contains("character")) && text.contains("attack")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("heroAttackGen");
+        return synergyRules[code].contains(SK_HERO_ATTACK_GEN);
     }
     else if((text.contains("hero") || text.contains("character")) && text.contains("attack"))
     {
@@ -2608,19 +2256,19 @@ bool SynergyHandler::isHeroAttackGen(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isSpellBuffGen(const QString &code, const QString &text, const QJsonArray &mechanics, const CardType &cardType)
+bool SynergyHandler::isSpellBuffGen(const QString &code, const QString &text, const CardTags &mechanics, const CardType &cardType)
 {
     //TEST
     //((text.contains("set") || text.contains("give")) &&
     //((text.contains("minion") && !text.contains("minions")) || (text.contains("character") && !text.contains("characters")))
-    //&& cardType == SPELL && !mechanics.contains("SECRET"))
-    if(synergyCodes.contains(code))
+    //&& cardType == SPELL && !mechanics.contains(TAG_SECRET)
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellBuffGen");
+        return synergyRules[code].contains(SK_SPELL_BUFF_GEN);
     }
     else if((text.contains("set") || text.contains("give")) &&
             ((text.contains("minion") && !text.contains("minions")) || (text.contains("character") && !text.contains("characters")))
-            && cardType == SPELL && !mechanics.contains("SECRET"))
+            && cardType == SPELL && !mechanics.contains(TAG_SECRET)
     {
         return true;
     }
@@ -2631,9 +2279,9 @@ bool SynergyHandler::isOtherClassGen(const QString &code, const QString &text, c
     //TEST
     //(text.contains("opponent") || text.contains("another")) && text.contains("class")
     //&& (cardClass == NEUTRAL || cardClass == ROGUE)
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("otherClassGen");
+        return synergyRules[code].contains(SK_OTHER_CLASS_GEN);
     }
     else if((text.contains("opponent") || text.contains("another")) && text.contains("class")
             && (cardClass == NEUTRAL || cardClass == ROGUE))
@@ -2647,9 +2295,9 @@ bool SynergyHandler::isSilverHandGen(const QString &code, const QString &text, c
     //TEST
     //text.contains("silver hand")
     //&& (cardClass == NEUTRAL || cardClass == PALADIN)
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("silverHandGen");
+        return synergyRules[code].contains(SK_SILVER_HAND_GEN);
     }
     else if(text.contains("silver hand")
             && (cardClass == NEUTRAL || cardClass == PALADIN))
@@ -2663,9 +2311,9 @@ bool SynergyHandler::isTreantGen(const QString &code, const QString &text, const
     //TEST
     //text.contains("treant")
     //&& (cardClass == NEUTRAL || cardClass == DRUID)
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("treantGen");
+        return synergyRules[code].contains(SK_TREANT_GEN);
     }
     else if(text.contains("treant")
             && (cardClass == NEUTRAL || cardClass == DRUID))
@@ -2678,9 +2326,9 @@ bool SynergyHandler::isLackeyGen(const QString &code, const QString &text)
 {
     //TEST
     //text.contains("lackey")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lackeyGen");
+        return synergyRules[code].contains(SK_LACKEY_GEN);
     }
     else if(text.contains("lackey"))
     {
@@ -2690,9 +2338,9 @@ bool SynergyHandler::isLackeyGen(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDrop2(const QString &code, int cost)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("drop2");
+        return synergyRules[code].contains(SK_DROP2);
     }
     else if(cost == 2)
     {
@@ -2702,9 +2350,9 @@ bool SynergyHandler::isDrop2(const QString &code, int cost)
 }
 bool SynergyHandler::isDrop3(const QString &code, int cost)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("drop3");
+        return synergyRules[code].contains(SK_DROP3);
     }
     else if(cost == 3)
     {
@@ -2714,9 +2362,9 @@ bool SynergyHandler::isDrop3(const QString &code, int cost)
 }
 bool SynergyHandler::isDrop4(const QString &code, int cost)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("drop4");
+        return synergyRules[code].contains(SK_DROP4);
     }
     else if(cost == 4)
     {
@@ -2731,9 +2379,9 @@ bool SynergyHandler::isDrop4(const QString &code, int cost)
 bool SynergyHandler::isSpellSyn(const QString &code)
 {
     //NO TEST
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellSyn");
+        return synergyRules[code].contains(SK_SPELL_SYN);
     }
     return false;
 }
@@ -2741,9 +2389,9 @@ bool SynergyHandler::isSpellAllSyn(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("spell")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellAllSyn");
+        return synergyRules[code].contains(SK_SPELL_ALL_SYN);
     }
     else
     {
@@ -2753,9 +2401,9 @@ bool SynergyHandler::isSpellAllSyn(const QString &code, const QString &text)
 bool SynergyHandler::isWeaponSyn(const QString &code)
 {
     //NO TEST
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("weaponSyn");
+        return synergyRules[code].contains(SK_WEAPON_SYN);
     }
     return false;
 }
@@ -2763,9 +2411,9 @@ bool SynergyHandler::isWeaponAllSyn(const QString &code, const QString &text)
 {
     //TEST
     //&& text.contains("weapon")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("weaponAllSyn");
+        return synergyRules[code].contains(SK_WEAPON_ALL_SYN);
     }
     else
     {
@@ -2774,17 +2422,17 @@ bool SynergyHandler::isWeaponAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isMurlocSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("murlocSyn");
+        return synergyRules[code].contains(SK_MURLOC_SYN);
     }
     return false;
 }
 bool SynergyHandler::isMurlocAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("murlocAllSyn");
+        return synergyRules[code].contains(SK_MURLOC_ALL_SYN);
     }
     else
     {
@@ -2793,17 +2441,17 @@ bool SynergyHandler::isMurlocAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDemonSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("demonSyn");
+        return synergyRules[code].contains(SK_DEMON_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDemonAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("demonAllSyn");
+        return synergyRules[code].contains(SK_DEMON_ALL_SYN);
     }
     else
     {
@@ -2812,17 +2460,17 @@ bool SynergyHandler::isDemonAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isMechSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("mechSyn");
+        return synergyRules[code].contains(SK_MECH_SYN);
     }
     return false;
 }
-bool SynergyHandler::isMechAllSyn(const QString &code, const QJsonArray &mechanics, const QString &text)
+bool SynergyHandler::isMechAllSyn(const QString &code, const CardTags &mechanics, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("mechAllSyn");
+        return synergyRules[code].contains(SK_MECH_ALL_SYN);
     }
     else if(isMagnetic(code, mechanics) || isMagneticGen(code))    return true;
     else
@@ -2832,17 +2480,17 @@ bool SynergyHandler::isMechAllSyn(const QString &code, const QJsonArray &mechani
 }
 bool SynergyHandler::isElementalSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("elementalSyn");
+        return synergyRules[code].contains(SK_ELEMENTAL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isElementalAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("elementalAllSyn");
+        return synergyRules[code].contains(SK_ELEMENTAL_ALL_SYN);
     }
     else
     {
@@ -2851,17 +2499,17 @@ bool SynergyHandler::isElementalAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isBeastSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("beastSyn");
+        return synergyRules[code].contains(SK_BEAST_SYN);
     }
     return false;
 }
 bool SynergyHandler::isBeastAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("beastAllSyn");
+        return synergyRules[code].contains(SK_BEAST_ALL_SYN);
     }
     else
     {
@@ -2870,17 +2518,17 @@ bool SynergyHandler::isBeastAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isTotemSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("totemSyn");
+        return synergyRules[code].contains(SK_TOTEM_SYN);
     }
     return false;
 }
 bool SynergyHandler::isTotemAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("totemAllSyn");
+        return synergyRules[code].contains(SK_TOTEM_ALL_SYN);
     }
     else
     {
@@ -2889,17 +2537,17 @@ bool SynergyHandler::isTotemAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isPirateSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("pirateSyn");
+        return synergyRules[code].contains(SK_PIRATE_SYN);
     }
     return false;
 }
 bool SynergyHandler::isPirateAllSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("pirateAllSyn");
+        return synergyRules[code].contains(SK_PIRATE_ALL_SYN);
     }
     else
     {
@@ -2908,9 +2556,9 @@ bool SynergyHandler::isPirateAllSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDragonSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("dragonSyn");
+        return synergyRules[code].contains(SK_DRAGON_SYN);
     }
     else
     {
@@ -2919,41 +2567,41 @@ bool SynergyHandler::isDragonSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDragonAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("dragonAllSyn");
+        return synergyRules[code].contains(SK_DRAGON_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDiscoverSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("discoverSyn");
+        return synergyRules[code].contains(SK_DISCOVER_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDrawSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("drawSyn");
+        return synergyRules[code].contains(SK_DRAW_SYN);
     }
     return false;
 }
 bool SynergyHandler::isToYourHandSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("toYourHandSyn");
+        return synergyRules[code].contains(SK_TO_YOUR_HAND_SYN);
     }
     return false;
 }
 bool SynergyHandler::isEnrageSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("enrageSyn");
+        return synergyRules[code].contains(SK_ENRAGE_SYN);
     }
     else if(text.contains("deal") && text.contains("1 damage") &&
             !text.contains("enemy") && !text.contains("random") && !text.contains("hero"))
@@ -2964,9 +2612,9 @@ bool SynergyHandler::isEnrageSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isOverloadSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("overloadSyn");
+        return synergyRules[code].contains(SK_OVERLOAD_SYN);
     }
     else if(text.contains("overload"))
     {
@@ -2977,51 +2625,51 @@ bool SynergyHandler::isOverloadSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isPingSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("pingSyn");
+        return synergyRules[code].contains(SK_PING_SYN);
     }
     return false;
 }
 bool SynergyHandler::isAoeSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("aoeSyn");
+        return synergyRules[code].contains(SK_AOE_SYN);
     }
     return false;
 }
 bool SynergyHandler::isTauntSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tauntSyn");
+        return synergyRules[code].contains(SK_TAUNT_SYN);
     }
     return false;
 }
 bool SynergyHandler::isTauntAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tauntAllSyn");
+        return synergyRules[code].contains(SK_TAUNT_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isSecretSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("secretSyn");
+        return synergyRules[code].contains(SK_SECRET_SYN);
     }
     return false;
 }
-bool SynergyHandler::isSecretAllSyn(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isSecretAllSyn(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("secretAllSyn");
+        return synergyRules[code].contains(SK_SECRET_ALL_SYN);
     }
-    else if(referencedTags.contains(QJsonValue("SECRET")))
+    else if(referencedTags.contains(TAG_SECRET))
     {
         return true;
     }
@@ -3029,57 +2677,57 @@ bool SynergyHandler::isSecretAllSyn(const QString &code, const QJsonArray &refer
 }
 bool SynergyHandler::isEchoSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("echoSyn");
+        return synergyRules[code].contains(SK_ECHO_SYN);
     }
     return false;
 }
 bool SynergyHandler::isEchoAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("echoAllSyn");
+        return synergyRules[code].contains(SK_ECHO_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isRushSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("rushSyn");
+        return synergyRules[code].contains(SK_RUSH_SYN);
     }
     return false;
 }
 bool SynergyHandler::isRushAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("rushAllSyn");
+        return synergyRules[code].contains(SK_RUSH_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isMagneticSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("magneticSyn");
+        return synergyRules[code].contains(SK_MAGNETIC_SYN);
     }
     return false;
 }
 bool SynergyHandler::isMagneticAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("magneticAllSyn");
+        return synergyRules[code].contains(SK_MAGNETIC_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isEggSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("eggSyn");
+        return synergyRules[code].contains(SK_EGG_SYN);
     }
     if(text.contains("swap") && text.contains("attack") && text.contains("health") && text.contains("minion"))
     {
@@ -3089,19 +2737,19 @@ bool SynergyHandler::isEggSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDamageFriendlyHeroSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("damageFriendlyHeroSyn");
+        return synergyRules[code].contains(SK_DAMAGE_FRIENDLY_HERO_SYN);
     }
     return false;
 }
-bool SynergyHandler::isFreezeEnemySyn(const QString &code, const QJsonArray &referencedTags, const QString &text)
+bool SynergyHandler::isFreezeEnemySyn(const QString &code, const CardTags &referencedTags, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("freezeEnemySyn");
+        return synergyRules[code].contains(SK_FREEZE_ENEMY_SYN);
     }
-    else if(referencedTags.contains(QJsonValue("FREEZE")))
+    else if(referencedTags.contains(TAG_FREEZE))
     {
         return text.contains("frozen");
     }
@@ -3109,9 +2757,9 @@ bool SynergyHandler::isFreezeEnemySyn(const QString &code, const QJsonArray &ref
 }
 bool SynergyHandler::isDiscardSyn(const QString &code, const QString &text)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("discardSyn");
+        return synergyRules[code].contains(SK_DISCARD_SYN);
     }
     else if(text.contains("discard") && !text.contains("random card"))
     {
@@ -3121,64 +2769,64 @@ bool SynergyHandler::isDiscardSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isDeathrattleSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("deathrattleSyn");
+        return synergyRules[code].contains(SK_DEATHRATTLE_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDeathrattleGoodAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("deathrattleGoodAllSyn");
+        return synergyRules[code].contains(SK_DEATHRATTLE_GOOD_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isBattlecrySyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("battlecrySyn");
+        return synergyRules[code].contains(SK_BATTLECRY_SYN);
     }
     return false;
 }
-bool SynergyHandler::isBattlecryAllSyn(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isBattlecryAllSyn(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("battlecryAllSyn");
+        return synergyRules[code].contains(SK_BATTLECRY_ALL_SYN);
     }
-    else if(referencedTags.contains(QJsonValue("BATTLECRY")))
+    else if(referencedTags.contains(TAG_BATTLECRY))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isSilenceOwnSyn(const QString &code, const QJsonArray &mechanics)
+bool SynergyHandler::isSilenceOwnSyn(const QString &code, const CardTags &mechanics)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("silenceOwnSyn");
+        return synergyRules[code].contains(SK_SILENCE_OWN_SYN);
     }
-    else if(mechanics.contains(QJsonValue("CANT_ATTACK")))
+    else if(mechanics.contains(TAG_CANT_ATTACK))
     {
         return true;
     }
     return false;
 }
-bool SynergyHandler::isTauntGiverSyn(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType)
+bool SynergyHandler::isTauntGiverSyn(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tauntGiverSyn") || synergyCodes[code].contains("deathrattleOpponent") ||
-               synergyCodes[code].contains("eggGen");
+        return synergyRules[code].contains(SK_TAUNT_GIVER_SYN) || synergyRules[code].contains(SK_DEATHRATTLE_OPPONENT) ||
+               synergyRules[code].contains(SK_EGG_GEN);
     }
-    else if(mechanics.contains(QJsonValue("CANT_ATTACK")))
+    else if(mechanics.contains(TAG_CANT_ATTACK))
     {
         return true;
     }
-    else if(cardType == MINION && attack == 0 && mechanics.contains(QJsonValue("DEATHRATTLE")) && !mechanics.contains(QJsonValue("TAUNT")))
+    else if(cardType == MINION && attack == 0 && mechanics.contains(TAG_DEATHRATTLE) && !mechanics.contains(TAG_TAUNT))
     {
         return true;
     }
@@ -3190,9 +2838,9 @@ bool SynergyHandler::isTokenSyn(const QString &code, const QString &text)
 //    && (text.contains("+") && (text.contains("minions") || text.contains("characters"))
 //    && !text.contains("hand") && !text.contains("health")
 //    || (text.contains("control") && text.contains("least") && text.contains("minions")))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tokenSyn");
+        return synergyRules[code].contains(SK_TOKEN_SYN);
     }
     else if(text.contains("+")
             && (text.contains("minions") || text.contains("characters"))
@@ -3210,9 +2858,9 @@ bool SynergyHandler::isTokenCardSyn(const QString &code, const QString &text)
 {
     //TEST
     //text.contains("play") && text.contains("card") && !text.contains("player")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("tokenCardSyn") || synergyCodes[code].contains("comboGen");
+        return synergyRules[code].contains(SK_TOKEN_CARD_SYN) || synergyRules[code].contains(SK_COMBO_GEN);
     }
     else if(text.contains("play") && text.contains("card") && !text.contains("player"))
     {
@@ -3220,13 +2868,13 @@ bool SynergyHandler::isTokenCardSyn(const QString &code, const QString &text)
     }
     return false;
 }
-bool SynergyHandler::isComboSyn(const QString &code, const QJsonArray &referencedTags)
+bool SynergyHandler::isComboSyn(const QString &code, const CardTags &referencedTags)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("comboSyn");
+        return synergyRules[code].contains(SK_COMBO_SYN);
     }
-    else if(referencedTags.contains(QJsonValue("COMBO")))
+    else if(referencedTags.contains(TAG_COMBO))
     {
         return true;
     }
@@ -3234,19 +2882,19 @@ bool SynergyHandler::isComboSyn(const QString &code, const QJsonArray &reference
 }
 bool SynergyHandler::isWindfuryMinionSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("windfuryMinionSyn");
+        return synergyRules[code].contains(SK_WINDFURY_MINION_SYN);
     }
     return false;
 }
-bool SynergyHandler::isAttackBuffSyn(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType)
+bool SynergyHandler::isAttackBuffSyn(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("attackBuffSyn") || synergyCodes[code].contains("eggGen");
+        return synergyRules[code].contains(SK_ATTACK_BUFF_SYN) || synergyRules[code].contains(SK_EGG_GEN);
     }
-    else if(cardType == MINION && attack == 0 && mechanics.contains(QJsonValue("DEATHRATTLE")) && !mechanics.contains(QJsonValue("TAUNT")))
+    else if(cardType == MINION && attack == 0 && mechanics.contains(TAG_DEATHRATTLE) && !mechanics.contains(TAG_TAUNT))
     {
         return true;
     }
@@ -3254,26 +2902,26 @@ bool SynergyHandler::isAttackBuffSyn(const QString &code, const QJsonArray &mech
 }
 bool SynergyHandler::isHealthBuffSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("healthBuffSyn");
+        return synergyRules[code].contains(SK_HEALTH_BUFF_SYN);
     }
     return false;
 }
-bool SynergyHandler::isReturnSyn(const QString &code, const QJsonArray &mechanics, const CardType &cardType, const QString &text)
+bool SynergyHandler::isReturnSyn(const QString &code, const CardTags &mechanics, const CardType &cardType, const QString &text)
 {
     //TEST
-    //&& mechanics.contains(QJsonValue("BATTLECRY"))
-    if(synergyCodes.contains(code))
+    //&& mechanics.contains(TAG_BATTLECRY)
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("returnSyn");
+        return synergyRules[code].contains(SK_RETURN_SYN);
     }
     else if(cardType != MINION)  return false;
-    else if(synergyCodes.contains(code))
+    else if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("echo");
+        return synergyRules[code].contains(SK_ECHO);
     }
-    else if(mechanics.contains(QJsonValue("BATTLECRY")) || mechanics.contains(QJsonValue("COMBO")))
+    else if(mechanics.contains(TAG_BATTLECRY) || mechanics.contains(TAG_COMBO))
     {
         if(
                 ((text.contains("summon") || text.contains("give") || text.contains("restore")) && !text.contains("opponent")) ||
@@ -3302,87 +2950,87 @@ bool SynergyHandler::isReturnSyn(const QString &code, const QJsonArray &mechanic
 }
 bool SynergyHandler::isStealthSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("stealthSyn");
+        return synergyRules[code].contains(SK_STEALTH_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDivineShieldSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("divineShieldSyn");
+        return synergyRules[code].contains(SK_DIVINE_SHIELD_SYN);
     }
     return false;
 }
 bool SynergyHandler::isDivineShieldAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("divineShieldAllSyn");
+        return synergyRules[code].contains(SK_DIVINE_SHIELD_ALL_SYN);
     }
     return false;
 }
 bool SynergyHandler::isRestoreTargetMinionSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreTargetMinionSyn");
+        return synergyRules[code].contains(SK_RESTORE_TARGET_MINION_SYN);
     }
     return false;
 }
 bool SynergyHandler::isRestoreFriendlyHeroSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreFriendlyHeroSyn");
+        return synergyRules[code].contains(SK_RESTORE_FRIENDLY_HERO_SYN);
     }
     return false;
 }
 bool SynergyHandler::isRestoreFriendlyMinionSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("restoreFriendlyMinionSyn");
+        return synergyRules[code].contains(SK_RESTORE_FRIENDLY_MINION_SYN);
     }
     return false;
 }
 bool SynergyHandler::isArmorSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("armorSyn");
+        return synergyRules[code].contains(SK_ARMOR_SYN);
     }
     return false;
 }
 bool SynergyHandler::isLifestealMinionSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lifestealMinionSyn");
+        return synergyRules[code].contains(SK_LIFESTEAL_MINION_SYN);
     }
     return false;
 }
 bool SynergyHandler::isLifestealAllSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lifestealAllSyn");
+        return synergyRules[code].contains(SK_LIFESTEAL_ALL_SYN);
     }
     return false;
 }
-bool SynergyHandler::isSpellDamageSyn(const QString &code, const QJsonArray &mechanics, const CardType &cardType, const QString &text)
+bool SynergyHandler::isSpellDamageSyn(const QString &code, const CardTags &mechanics, const CardType &cardType, const QString &text)
 {
     //TEST
 //    && (text.contains("all") || text.contains("adjacent")) && (text.contains("damage"))
 //    && cardType == SPELL
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellDamageSyn");
+        return synergyRules[code].contains(SK_SPELL_DAMAGE_SYN);
     }
     else if(cardType != SPELL)  return false;
-    else if(mechanics.contains(QJsonValue("SECRET")))   return false;
+    else if(mechanics.contains(TAG_SECRET))   return false;
     else if(
             (text.contains("all") || text.contains("adjacent")) && (text.contains("damage"))
             && !text.contains("random")
@@ -3394,17 +3042,17 @@ bool SynergyHandler::isSpellDamageSyn(const QString &code, const QJsonArray &mec
 }
 bool SynergyHandler::isEvolveSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("evolveSyn");
+        return synergyRules[code].contains(SK_EVOLVE_SYN);
     }
     return false;
 }
 bool SynergyHandler::isSpawnEnemySyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spawnEnemySyn");
+        return synergyRules[code].contains(SK_SPAWN_ENEMY_SYN);
     }
     return false;
 }
@@ -3412,9 +3060,9 @@ bool SynergyHandler::isHandBuffSyn(const QString &code, const QString &text)
 {
     //TEST
     //((text.contains("enchantments")) || (text.contains("of this minion")))
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("handBuffSyn");
+        return synergyRules[code].contains(SK_HAND_BUFF_SYN);
     }
     else if((text.contains("enchantments")) || (text.contains("of this minion")))
     {
@@ -3426,9 +3074,9 @@ bool SynergyHandler::isEnemyDrawSyn(const QString &code, const QString &text)
 {
     //TEST
     //text.contains("shuffle") && (text.contains("opponent") || text.contains("enemy")) && text.contains("deck") && text.contains("when drawn")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("enemyDrawSyn");
+        return synergyRules[code].contains(SK_ENEMY_DRAW_SYN);
     }
     else if(text.contains("shuffle") && (text.contains("opponent") || text.contains("enemy")) &&
             text.contains("deck") && text.contains("when drawn"))
@@ -3439,9 +3087,9 @@ bool SynergyHandler::isEnemyDrawSyn(const QString &code, const QString &text)
 }
 bool SynergyHandler::isHeroAttackSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("heroAttackSyn");
+        return synergyRules[code].contains(SK_HERO_ATTACK_SYN);
     }
     return false;
 }
@@ -3449,9 +3097,9 @@ bool SynergyHandler::isSpellBuffSyn(const QString &code, const QString &text)
 {
     //TEST
     //(text.contains("spell") && text.contains("cast") && text.contains("minion")) || text.contains("enchantments")
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("spellBuffSyn");
+        return synergyRules[code].contains(SK_SPELL_BUFF_SYN);
     }
     else if((text.contains("spell") && text.contains("cast") && text.contains("minion")) || text.contains("enchantments"))
     {
@@ -3464,9 +3112,9 @@ bool SynergyHandler::isOtherClassSyn(const QString &code, const QString &text, c
     //TEST
     //text.contains("card") && text.contains("from another class")
     //&& (cardClass == NEUTRAL || cardClass == ROGUE)
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("otherClassSyn");
+        return synergyRules[code].contains(SK_OTHER_CLASS_SYN);
     }
     else if(text.contains("card") && text.contains("from another class")
             && (cardClass == NEUTRAL || cardClass == ROGUE))
@@ -3477,25 +3125,25 @@ bool SynergyHandler::isOtherClassSyn(const QString &code, const QString &text, c
 }
 bool SynergyHandler::isSilverHandSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("silverHandSyn");
+        return synergyRules[code].contains(SK_SILVER_HAND_SYN);
     }
     return false;
 }
 bool SynergyHandler::isTreantSyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("treantSyn");
+        return synergyRules[code].contains(SK_TREANT_SYN);
     }
     return false;
 }
 bool SynergyHandler::isLackeySyn(const QString &code)
 {
-    if(synergyCodes.contains(code))
+    if(synergyRules.contains(code))
     {
-        return synergyCodes[code].contains("lackeySyn");
+        return synergyRules[code].contains(SK_LACKEY_SYN);
     }
     return false;
 }
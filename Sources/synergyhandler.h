@@ -6,9 +6,22 @@
 #include "Synergies/draftitemcounter.h"
 #include "Synergies/draftdropcounter.h"
 #include "Synergies/statsynergies.h"
+#include "Synergies/synergyrules.h"
+#include "Synergies/draftdeckstate.h"
+#include "Synergies/synergymatcher.h"
 #include "utility.h"
 
 
+//Resultado de getSynergies para una carta con una version del mazo
+class CardSynergies
+{
+public:
+    QMap<QString, int> synergies;
+    QMap<QString, int> mechanicIcons;
+    MechanicBorderColor dropBorderColor;
+};
+
+
 class SynergyHandler : public QObject
 {
     Q_OBJECT
@@ -19,12 +32,18 @@ public:
 //Variables
 private:
     Ui::Extended *ui;
-    QMap<QString, QList<QString>> synergyCodes, directLinks;
+    QHash<QString, CardSynergyRules> synergyRules;
+    QMap<QString, QList<QString>> directLinks;
     StatSynergies costMinions, attackMinions, healthMinions, costSpells;
 //    StatSynergies costWeapons, attackWeapons, healthWeapons;
     DraftItemCounter **raceCounters, **cardTypeCounters, **mechanicCounters;
     DraftItemCounter *manaCounter;
     DraftDropCounter **dropCounters;
+    DraftDeckState deckState;
+    SynergyMatcher synergyMatcher;
+    QHash<QString, CardCounterData> cardCounterDataCache;
+    QHash<QString, CardSynergies> synergiesCache;
+    quint32 synergiesCacheVersion;
     QHBoxLayout *horLayoutCardTypes, *horLayoutDrops, *horLayoutMechanics1, *horLayoutMechanics2;
 
 //Metodos
@@ -41,15 +60,19 @@ public:
     void updateCounters(DeckCard &deckCard, QStringList &spellList, QStringList &minionList, QStringList &weaponList,
                         QStringList &drop2List, QStringList &drop3List, QStringList &drop4List,
                         QStringList &aoeList, QStringList &tauntList, QStringList &survivabilityList, QStringList &drawList,
-                        QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList, int &draw, int &toYourHand, int &discover);
+                        QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList, int &draw, int &toYourHand, int &discover,
+                        int num=1);
     void getSynergies(DeckCard &deckCard, QMap<QString, int> &synergies, QMap<QString, int> &mechanicIcons, MechanicBorderColor &dropBorderColor);
     void initSynergyCodes();
+    void precompileCardData(const QStringList &codes);
     void clearLists(bool keepCounters);
     int draftedCardsCount();
     void setTransparency(Transparency transparency, bool mouseInApp);
     void setTheme();
     int getCorrectedCardMana(DeckCard &deckCard);
     int getManaCounterCount();
+    const CardCounterData &getCardCounterData(DeckCard &deckCard);
+    const DraftDeckState &getDeckState();
     void setHidden(bool hide);
 
     bool isDrop2(const QString &code, int cost);
@@ -62,19 +85,14 @@ private:
     void codeMap2CodeList(const QMap<QString, int> &codeMap, QStringList &codeList);
     bool containsAll(const QString &text, const QString &words);
 
-    void updateManaCounter(DeckCard &deckCard);
-    void updateRaceCounters(DeckCard &deckCard);
-    void updateCardTypeCounters(DeckCard &deckCard, QStringList &spellList, QStringList &minionList, QStringList &weaponList);
-    void updateDropCounters(DeckCard &deckCard, QStringList &drop2List, QStringList &drop3List, QStringList &drop4List);
-    void updateMechanicCounters(DeckCard &deckCard,
-                                QStringList &aoeList, QStringList &tauntList, QStringList &survivabilityList, QStringList &drawList,
-                                QStringList &pingList, QStringList &damageList, QStringList &destroyList, QStringList &reachList, int &draw, int &toYourHand, int &discover);
+    void fillRaceCounterData(DeckCard &deckCard, CardCounterData &data);
+    void fillCardTypeCounterData(DeckCard &deckCard, CardCounterData &data);
+    void fillDropCounterData(DeckCard &deckCard, CardCounterData &data);
+    void fillMechanicCounterData(DeckCard &deckCard, CardCounterData &data);
     void updateStatsCards(DeckCard &deckCard);
 
-    void getCardTypeSynergies(DeckCard &deckCard, QMap<QString, int> &synergies);
-    void getDropMechanicIcons(DeckCard &deckCard, QMap<QString, int> &mechanicIcons, MechanicBorderColor &dropBorderColor);
-    void getRaceSynergies(DeckCard &deckCard, QMap<QString, int> &synergies);
-    void getMechanicSynergies(DeckCard &deckCard, QMap<QString, int> &synergies, QMap<QString, int> &mechanicIcons);
+    void getDropMechanicIcons(const CardCounterData &data, QMap<QString, int> &mechanicIcons, MechanicBorderColor &dropBorderColor);
+    void getMechanicIcons(const CardCounterData &data, QMap<QString, int> &mechanicIcons);
     void getDirectLinkSynergies(DeckCard &deckCard, QMap<QString, int> &synergies);
     void getStatsCardsSynergies(DeckCard &deckCard, QMap<QString, int> &synergies);
 
@@ -88,66 +106,66 @@ private:
     bool isTotemGen(const QString &code);
     bool isPirateGen(const QString &code);
     bool isDragonGen(const QString &code);
-    bool isDiscoverDrawGen(const QString &code, int cost, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text);
-    bool isDiscoverGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags);
+    bool isDiscoverDrawGen(const QString &code, int cost, const CardTags &mechanics, const CardTags &referencedTags, const QString &text);
+    bool isDiscoverGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags);
     bool isDrawGen(const QString &code, const QString &text);
-    bool isToYourHandGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text);
-    int numDiscoverGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags);
+    bool isToYourHandGen(const QString &code, int cost, const CardTags &mechanics, const QString &text);
+    int numDiscoverGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags);
     int numDrawGen(const QString &code, const QString &text);
-    int numToYourHandGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text);
-    bool isTaunt(const QString &code, const QJsonArray &mechanics);
-    bool isTauntGen(const QString &code, const QJsonArray &referencedTags);
+    int numToYourHandGen(const QString &code, int cost, const CardTags &mechanics, const QString &text);
+    bool isTaunt(const QString &code, const CardTags &mechanics);
+    bool isTauntGen(const QString &code, const CardTags &referencedTags);
     bool isAoeGen(const QString &code, const QString &text);
-    bool isDamageMinionsGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text, const CardType &cardType, int attack);
-    bool isDestroyGen(const QString &code, const QJsonArray &mechanics, const QString &text);
-    bool isPingGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags,
+    bool isDamageMinionsGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const QString &text, const CardType &cardType, int attack);
+    bool isDestroyGen(const QString &code, const CardTags &mechanics, const QString &text);
+    bool isPingGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags,
                    const QString &text, const CardType &cardType, int attack);
-    bool isReachGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text, const CardType &cardType, int attack);
-    bool isEnrageGen(const QString &code, const QJsonArray &mechanics);
+    bool isReachGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const QString &text, const CardType &cardType, int attack);
+    bool isEnrageGen(const QString &code, const CardTags &mechanics);
     bool isOverload(const QString &code);
-    bool isJadeGolemGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags);
+    bool isJadeGolemGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags);
     bool isHeroPowerGen(const QString &code, const QString &text, const CardClass &cardClass);
-    bool isSecret(const QString &code, const QJsonArray &mechanics);
+    bool isSecret(const QString &code, const CardTags &mechanics);
     bool isSecretGen(const QString &code);
-    bool isEcho(const QString &code, const QJsonArray &mechanics);
-    bool isEchoGen(const QString &code, const QJsonArray &referencedTags);
-    bool isRush(const QString &code, const QJsonArray &mechanics);
-    bool isRushGen(const QString &code, const QJsonArray &referencedTags);
-    bool isMagnetic(const QString &code, const QJsonArray &mechanics);
+    bool isEcho(const QString &code, const CardTags &mechanics);
+    bool isEchoGen(const QString &code, const CardTags &referencedTags);
+    bool isRush(const QString &code, const CardTags &mechanics);
+    bool isRushGen(const QString &code, const CardTags &referencedTags);
+    bool isMagnetic(const QString &code, const CardTags &mechanics);
     bool isMagneticGen(const QString &code);
-    bool isEggGen(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType);
+    bool isEggGen(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType);
     bool isDamageFriendlyHeroGen(const QString &code);
-    bool isFreezeEnemyGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text);
+    bool isFreezeEnemyGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const QString &text);
     bool isDiscardGen(const QString &code, const QString &text);
-    bool isDeathrattleMinion(const QString &code, const QJsonArray &mechanics, const CardType &cardType);
-    bool isDeathrattleGoodAll(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const CardType &cardType);
-    bool isBattlecry(const QString &code, const QJsonArray &mechanics);
+    bool isDeathrattleMinion(const QString &code, const CardTags &mechanics, const CardType &cardType);
+    bool isDeathrattleGoodAll(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const CardType &cardType);
+    bool isBattlecry(const QString &code, const CardTags &mechanics);
     bool isBattlecryGen(const QString &code);
-    bool isSilenceOwnGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags);
+    bool isSilenceOwnGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags);
     bool isTauntGiverGen(const QString &code);
     bool isTokenGen(const QString &code, const QString &text);
-    bool isTokenCardGen(const QString &code, int cost, const QJsonArray &mechanics, const QString &text);
-    bool isComboGen(const QString &code, const QJsonArray &mechanics);
-    bool isWindfuryMinion(const QString &code, const QJsonArray &mechanics, const CardType &cardType);
+    bool isTokenCardGen(const QString &code, int cost, const CardTags &mechanics, const QString &text);
+    bool isComboGen(const QString &code, const CardTags &mechanics);
+    bool isWindfuryMinion(const QString &code, const CardTags &mechanics, const CardType &cardType);
     bool isAttackBuffGen(const QString &code, const QString &text);
     bool isHealthBuffGen(const QString &code, const QString &text);
     bool isReturnGen(const QString &code, const QString &text);
-    bool isStealthGen(const QString &code, const QJsonArray &mechanics);
-    bool isDivineShield(const QString &code, const QJsonArray &mechanics);
-    bool isDivineShieldGen(const QString &code, const QJsonArray &referencedTags);
+    bool isStealthGen(const QString &code, const CardTags &mechanics);
+    bool isDivineShield(const QString &code, const CardTags &mechanics);
+    bool isDivineShieldGen(const QString &code, const CardTags &referencedTags);
     bool isRestoreTargetMinionGen(const QString &code, const QString &text);
-    bool isRestoreFriendlyHeroGen(const QString &code, const QJsonArray &mechanics, const QJsonArray &referencedTags, const QString &text);
+    bool isRestoreFriendlyHeroGen(const QString &code, const CardTags &mechanics, const CardTags &referencedTags, const QString &text);
     bool isRestoreFriendlyMinionGen(const QString &code, const QString &text);
     bool isArmorGen(const QString &code, const QString &text);
-    bool isLifestealMinon(const QString &code, const QJsonArray &mechanics, const CardType &cardType);
-    bool isLifestealGen(const QString &code, const QJsonArray &referencedTags);
+    bool isLifestealMinon(const QString &code, const CardTags &mechanics, const CardType &cardType);
+    bool isLifestealGen(const QString &code, const CardTags &referencedTags);
     bool isSpellDamageGen(const QString &code);
     bool isEvolveGen(const QString &code, const QString &text);
     bool isSpawnEnemyGen(const QString &code, const QString &text);
     bool isHandBuffGen(const QString &code, const QString &text);
     bool isEnemyDrawGen(const QString &code, const QString &text);
     bool isHeroAttackGen(const QString &code, const QString &text);
-    bool isSpellBuffGen(const QString &code, const QString &text, const QJsonArray &mechanics, const CardType &cardType);
+    bool isSpellBuffGen(const QString &code, const QString &text, const CardTags &mechanics, const CardType &cardType);
     bool isOtherClassGen(const QString &code, const QString &text, const CardClass &cardClass);
     bool isSilverHandGen(const QString &code, const QString &text, const CardClass &cardClass);
     bool isTreantGen(const QString &code, const QString &text, const CardClass &cardClass);
@@ -163,7 +181,7 @@ private:
     bool isDragonSyn(const QString &code, const QString &text);
     bool isMurlocAllSyn(const QString &code, const QString &text);
     bool isDemonAllSyn(const QString &code, const QString &text);
-    bool isMechAllSyn(const QString &code, const QJsonArray &mechanics, const QString &text);
+    bool isMechAllSyn(const QString &code, const CardTags &mechanics, const QString &text);
     bool isElementalAllSyn(const QString &code, const QString &text);
     bool isBeastAllSyn(const QString &code, const QString &text);
     bool isTotemAllSyn(const QString &code, const QString &text);
@@ -183,7 +201,7 @@ private:
     bool isTauntSyn(const QString &code);
     bool isTauntAllSyn(const QString &code);
     bool isSecretSyn(const QString &code);
-    bool isSecretAllSyn(const QString &code, const QJsonArray &referencedTags);
+    bool isSecretAllSyn(const QString &code, const CardTags &referencedTags);
     bool isEchoSyn(const QString &code);
     bool isEchoAllSyn(const QString &code);
     bool isRushSyn(const QString &code);
@@ -192,21 +210,21 @@ private:
     bool isMagneticAllSyn(const QString &code);
     bool isEggSyn(const QString &code, const QString &text);
     bool isDamageFriendlyHeroSyn(const QString &code);
-    bool isFreezeEnemySyn(const QString &code, const QJsonArray &referencedTags, const QString &text);
+    bool isFreezeEnemySyn(const QString &code, const CardTags &referencedTags, const QString &text);
     bool isDiscardSyn(const QString &code, const QString &text);
     bool isDeathrattleSyn(const QString &code);
     bool isDeathrattleGoodAllSyn(const QString &code);
     bool isBattlecrySyn(const QString &code);
-    bool isBattlecryAllSyn(const QString &code, const QJsonArray &referencedTags);
-    bool isSilenceOwnSyn(const QString &code, const QJsonArray &mechanics);
-    bool isTauntGiverSyn(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType);
+    bool isBattlecryAllSyn(const QString &code, const CardTags &referencedTags);
+    bool isSilenceOwnSyn(const QString &code, const CardTags &mechanics);
+    bool isTauntGiverSyn(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType);
     bool isTokenSyn(const QString &code, const QString &text);
     bool isTokenCardSyn(const QString &code, const QString &text);
-    bool isComboSyn(const QString &code, const QJsonArray &referencedTags);
+    bool isComboSyn(const QString &code, const CardTags &referencedTags);
     bool isWindfuryMinionSyn(const QString &code);
-    bool isAttackBuffSyn(const QString &code, const QJsonArray &mechanics, int attack, const CardType &cardType);
+    bool isAttackBuffSyn(const QString &code, const CardTags &mechanics, int attack, const CardType &cardType);
     bool isHealthBuffSyn(const QString &code);
-    bool isReturnSyn(const QString &code, const QJsonArray &mechanics, const CardType &cardType, const QString &text);
+    bool isReturnSyn(const QString &code, const CardTags &mechanics, const CardType &cardType, const QString &text);
     bool isStealthSyn(const QString &code);
     bool isDivineShieldSyn(const QString &code);
     bool isDivineShieldAllSyn(const QString &code);
@@ -216,7 +234,7 @@ private:
     bool isArmorSyn(const QString &code);
     bool isLifestealMinionSyn(const QString &code);
     bool isLifestealAllSyn(const QString &code);
-    bool isSpellDamageSyn(const QString &code, const QJsonArray &mechanics, const CardType &cardType, const QString &text);
+    bool isSpellDamageSyn(const QString &code, const CardTags &mechanics, const CardType &cardType, const QString &text);
     bool isEvolveSyn(const QString &code);
     bool isSpawnEnemySyn(const QString &code);
     bool isHandBuffSyn(const QString &code, const QString &text);
@@ -12,9 +12,16 @@ using namespace std;
 
 
 QMap<QString, QJsonObject> * Utility::cardsJson = nullptr;
+QHash<QString, CardRuleData> Utility::cardsRuleData;
+CardNameIndex Utility::cardsNameIndex;
+QMutex Utility::cardsNameIndexMutex;
+QSet<QString> Utility::cardImagesIndex;
+bool Utility::cardImagesIndexBuilt = false;
+QMutex Utility::cardImagesMutex;
+QMap<QString, QSharedPointer<const TemplateFeatures>> Utility::templatesFeatures;
+QMutex Utility::templatesMutex;
 QString Utility::localLang = "enUS";
-QString Utility::diacriticLetters;
-QStringList Utility::noDiacriticLetters;
+QHash<QChar, QString> Utility::noDiacriticLetters;
 
 Utility::Utility()
 {
@@ -31,105 +38,113 @@ Utility::~Utility()
 //----Conversiones de clases
 //----NEW HERO CLASS
 //--------------------------------------------------------
+//Indexada por CardClass (orden alfabetico), INVALID_CLASS y NEUTRAL solo tienen color.
+class ClassInfo
+{
+public:
+    const char *logNumber;
+    const char *uName;
+    const char *ulName;
+    const char *ul_ulName;
+    const char *color;
+};
+
+static constexpr ClassInfo classInfoTable[NEUTRAL+1] = {
+    {"10", "DEMONHUNTER", "Demonhunter", "Demon Hunter", "#1e5b3d"},
+    {"06", "DRUID",       "Druid",       "Druid",        "#7f4f29"},
+    {"05", "HUNTER",      "Hunter",      "Hunter",       "#347c2c"},
+    {"08", "MAGE",        "Mage",        "Mage",         "#699cd5"},
+    {"04", "PALADIN",     "Paladin",     "Paladin",      "#de9a3e"},
+    {"09", "PRIEST",      "Priest",      "Priest",       "#a4a4a4"},
+    {"03", "ROGUE",       "Rogue",       "Rogue",        "#4c4e54"},
+    {"02", "SHAMAN",      "Shaman",      "Shaman",       "#0070DE"},
+    {"07", "WARLOCK",     "Warlock",     "Warlock",      "#6c4177"},
+    {"01", "WARRIOR",     "Warrior",     "Warrior",      "#912a21"},
+    {"",   "",            "",            "",             "#A9A9A9"},//INVALID_CLASS
+    {"",   "",            "",            "",             ""}        //NEUTRAL
+};
+
+//Indexada por log number (01 - 10)
+static constexpr CardClass logNumberClasses[NUM_HEROS+1] = {
+    INVALID_CLASS, WARRIOR, SHAMAN, ROGUE, PALADIN, HUNTER, DRUID, WARLOCK, MAGE, PRIEST, DEMONHUNTER
+};
+
+
+//Solo acepta "01"-"10" (dos digitos, igual que el log) sin crear strings intermedios
+CardClass Utility::parseClassLogNumber(const QString &hero)
+{
+    if(hero.length() != 2)  return INVALID_CLASS;
+
+    int tens = hero[0].digitValue();
+    int units = hero[1].digitValue();
+    if(tens < 0 || units < 0)   return INVALID_CLASS;
+
+    int logNumber = tens*10 + units;
+    if(logNumber < 1 || logNumber > NUM_HEROS)  return INVALID_CLASS;
+    return logNumberClasses[logNumber];
+}
+
+
+bool Utility::isValidHeroClass(CardClass cardClass)
+{
+    return cardClass >= DEMONHUNTER && cardClass < INVALID_CLASS;
+}
+
+
 QString Utility::className2classLogNumber(const QString &hero)
 {
-    if(hero.toLower().compare("druid")==0)        return QString("06");
-    else if(hero.toLower().compare("hunter")==0)  return QString("05");
-    else if(hero.toLower().compare("mage")==0)    return QString("08");
-    else if(hero.toLower().compare("paladin")==0) return QString("04");
-    else if(hero.toLower().compare("priest")==0)  return QString("09");
-    else if(hero.toLower().compare("rogue")==0)   return QString("03");
-    else if(hero.toLower().compare("shaman")==0)  return QString("02");
-    else if(hero.toLower().compare("warlock")==0) return QString("07");
-    else if(hero.toLower().compare("warrior")==0) return QString("01");
-    else if(hero.toLower().compare("demonhunter")==0) return QString("10");
-    else return QString();
+    for(int i=0; i<NUM_HEROS; i++)
+    {
+        if(hero.compare(QLatin1String(classInfoTable[i].ulName), Qt::CaseInsensitive)==0)
+        {
+            return QString(classInfoTable[i].logNumber);
+        }
+    }
+    return QString();
 }
 
 
 QString Utility::classEnum2classLogNumber(CardClass cardClass)
 {
-    if(cardClass == DRUID)        return QString("06");
-    else if(cardClass == HUNTER)  return QString("05");
-    else if(cardClass == MAGE)    return QString("08");
-    else if(cardClass == PALADIN) return QString("04");
-    else if(cardClass == PRIEST)  return QString("09");
-    else if(cardClass == ROGUE)   return QString("03");
-    else if(cardClass == SHAMAN)  return QString("02");
-    else if(cardClass == WARLOCK) return QString("07");
-    else if(cardClass == WARRIOR) return QString("01");
-    else if(cardClass == DEMONHUNTER) return QString("10");
-    else return QString();
+    if(!isValidHeroClass(cardClass))    return QString();
+    return QString(classInfoTable[cardClass].logNumber);
 }
 
 
 QString Utility::classEnum2classUName(CardClass cardClass)
 {
-    if(cardClass == DRUID)        return QString("DRUID");
-    else if(cardClass == HUNTER)  return QString("HUNTER");
-    else if(cardClass == MAGE)    return QString("MAGE");
-    else if(cardClass == PALADIN) return QString("PALADIN");
-    else if(cardClass == PRIEST)  return QString("PRIEST");
-    else if(cardClass == ROGUE)   return QString("ROGUE");
-    else if(cardClass == SHAMAN)  return QString("SHAMAN");
-    else if(cardClass == WARLOCK) return QString("WARLOCK");
-    else if(cardClass == WARRIOR) return QString("WARRIOR");
-    else if(cardClass == DEMONHUNTER) return QString("DEMONHUNTER");
-    else return QString();
+    if(!isValidHeroClass(cardClass))    return QString();
+    return QString(classInfoTable[cardClass].uName);
 }
 
 
 CardClass Utility::classLogNumber2classEnum(QString hero)
 {
-    if(hero == QString("06"))       return DRUID;
-    else if(hero == QString("05"))  return HUNTER;
-    else if(hero == QString("08"))  return MAGE;
-    else if(hero == QString("04"))  return PALADIN;
-    else if(hero == QString("09"))  return PRIEST;
-    else if(hero == QString("03"))  return ROGUE;
-    else if(hero == QString("02"))  return SHAMAN;
-    else if(hero == QString("07"))  return WARLOCK;
-    else if(hero == QString("01"))  return WARRIOR;
-    else if(hero == QString("10"))  return DEMONHUNTER;
-    else                            return INVALID_CLASS;
+    return parseClassLogNumber(hero);
 }
 
 
 QString Utility::classLogNumber2classUL_ULName(QString hero)
 {
-    if(hero == QString("06"))       return "Druid";
-    else if(hero == QString("05"))  return "Hunter";
-    else if(hero == QString("08"))  return "Mage";
-    else if(hero == QString("04"))  return "Paladin";
-    else if(hero == QString("09"))  return "Priest";
-    else if(hero == QString("03"))  return "Rogue";
-    else if(hero == QString("02"))  return "Shaman";
-    else if(hero == QString("07"))  return "Warlock";
-    else if(hero == QString("01"))  return "Warrior";
-    else if(hero == QString("10"))  return "Demon Hunter";
-    else                            return "";
+    CardClass cardClass = parseClassLogNumber(hero);
+    if(!isValidHeroClass(cardClass))    return "";
+    return QString(classInfoTable[cardClass].ul_ulName);
 }
 
 
 QString Utility::classLogNumber2classULName(QString hero)
 {
-    if(hero == QString("06"))       return "Druid";
-    else if(hero == QString("05"))  return "Hunter";
-    else if(hero == QString("08"))  return "Mage";
-    else if(hero == QString("04"))  return "Paladin";
-    else if(hero == QString("09"))  return "Priest";
-    else if(hero == QString("03"))  return "Rogue";
-    else if(hero == QString("02"))  return "Shaman";
-    else if(hero == QString("07"))  return "Warlock";
-    else if(hero == QString("01"))  return "Warrior";
-    else if(hero == QString("10"))  return "Demonhunter";
-    else                            return "";
+    CardClass cardClass = parseClassLogNumber(hero);
+    if(!isValidHeroClass(cardClass))    return "";
+    return QString(classInfoTable[cardClass].ulName);
 }
 
 
 QString Utility::classLogNumber2classUName(QString hero)
 {
-    return Utility::classLogNumber2classULName(hero).toUpper();
+    CardClass cardClass = parseClassLogNumber(hero);
+    if(!isValidHeroClass(cardClass))    return "";
+    return QString(classInfoTable[cardClass].uName);
 }
 
 
@@ -145,42 +160,38 @@ QString Utility::classLogNumber2classLName(QString hero)
 //--------------------------------------------------------
 QString Utility::classOrder2classColor(int order)
 {
-    QString heroesColors[NUM_HEROS+1] = {"#1e5b3d", "#7f4f29", "#347c2c", "#699cd5", "#de9a3e", "#a4a4a4", "#4c4e54", "#0070DE", "#6c4177", "#912a21", "#A9A9A9"};
     if(order < 0 || order > NUM_HEROS)    return "";
-    return heroesColors[order];
+    return QString(classInfoTable[order].color);
 }
 
 
 QString Utility::classOrder2classULName(int order)
 {
-    QString heroes[NUM_HEROS] = {"Demonhunter", "Druid", "Hunter", "Mage", "Paladin", "Priest", "Rogue", "Shaman", "Warlock", "Warrior"};
     if(order < 0 || order > (NUM_HEROS-1))  return "";
-    return heroes[order];
+    return QString(classInfoTable[order].ulName);
 }
 
 
 QString Utility::classOrder2classUL_ULName(int order)
 {
-    QString heroes[NUM_HEROS] = {"Demon Hunter", "Druid", "Hunter", "Mage", "Paladin", "Priest", "Rogue", "Shaman", "Warlock", "Warrior"};
     if(order < 0 || order > (NUM_HEROS-1))  return "";
-    return heroes[order];
+    return QString(classInfoTable[order].ul_ulName);
 }
 
 
 QString Utility::classOrder2classLogNumber(int order)
 {
-    QString heroesLogNumber[NUM_HEROS] = {"10", "06", "05", "08", "04", "09", "03", "02", "07", "01"};
     if(order < 0 || order > (NUM_HEROS-1))  return "";
-    return heroesLogNumber[order];
+    return QString(classInfoTable[order].logNumber);
 }
 
 
+//Como antes acepta cualquier entero (toInt), no solo "01"-"10"
 int Utility::classLogNumber2classOrder(QString heroLog)
 {
-    int heroeOrder[NUM_HEROS] = {9, 7, 6, 4, 2, 1, 8, 3, 5, 0};
-    int heroLogInt = heroLog.toInt() - 1;
-    if(heroLogInt < 0 || heroLogInt > (NUM_HEROS-1))    return -1;
-    return heroeOrder[heroLogInt];
+    int logNumber = heroLog.toInt();
+    if(logNumber < 1 || logNumber > NUM_HEROS)  return -1;
+    return logNumberClasses[logNumber];
 }
 
 
@@ -236,15 +247,46 @@ QString Utility::cardEnTextFromCode(QString code)
 }
 
 
+//Texto en minusculas y tags de cada carta, se calculan una sola vez al cargar cards.json
+void Utility::buildCardsRuleData()
+{
+    cardsRuleData.clear();
+    cardsRuleData.reserve(cardsJson->count());
+    for(QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+    {
+        CardRuleData &ruleData = cardsRuleData[it.key()];
+        QString text = it->value("text").toObject().value("enUS").toString();
+        text.replace('\n',' ');
+        text.replace(QChar(160), ' ');
+        ruleData.text = text.toLower();
+        ruleData.mechanics = CardTags(it->value("mechanics").toArray());
+        ruleData.referencedTags = CardTags(it->value("referencedTags").toArray());
+    }
+}
+
+
+const CardRuleData &Utility::getCardRuleData(const QString &code)
+{
+    static const CardRuleData emptyRuleData;
+    QHash<QString, CardRuleData>::const_iterator it = cardsRuleData.constFind(code);
+    if(it == cardsRuleData.constEnd())  return emptyRuleData;
+    return it.value();
+}
+
+
 QString Utility::cardEnCodeFromName(QString name, bool onlyCollectible)
 {
-    for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+    QMutexLocker locker(&cardsNameIndexMutex);
+
+    //El indice ignora acentos/mayusculas e incluye todos los idiomas, comprobamos el nombre exacto
+    for(const QString &code: cardsNameIndex.exactCodes(name))
     {
-        if(it->value("name").toObject().value("enUS").toString() == name)
+        const QJsonObject &cardObject = (*cardsJson)[code];
+        if(cardObject.value("name").toObject().value("enUS").toString() == name)
         {
-            if(!onlyCollectible || ((it->value("collectible").toBool()) && (!it.key().startsWith("HERO_"))))
+            if(!onlyCollectible || ((cardObject.value("collectible").toBool()) && (!code.startsWith("HERO_"))))
             {
-                return it.key();
+                return code;
             }
         }
     }
@@ -253,13 +295,17 @@ QString Utility::cardEnCodeFromName(QString name, bool onlyCollectible)
 }
 
 
+//Solo nombre exacto en localLang: resuelve las cartas del log, nunca aproximamos
 QString Utility::cardLocalCodeFromName(QString name)
 {
-    for (QMap<QString, QJsonObject>::const_iterator it = cardsJson->cbegin(); it != cardsJson->cend(); it++)
+    QMutexLocker locker(&cardsNameIndexMutex);
+
+    for(const QString &code: cardsNameIndex.exactCodes(name))
     {
-        if(it->value("name").toObject().value(localLang).toString() == name)
+        const QJsonObject &cardObject = (*cardsJson)[code];
+        if(cardObject.value("name").toObject().value(localLang).toString() == name)
         {
-            if(!it->value("cost").isUndefined())    return it.key();
+            if(!cardObject.value("cost").isUndefined())    return code;
         }
     }
 
@@ -267,6 +313,38 @@ QString Utility::cardLocalCodeFromName(QString name)
 }
 
 
+QStringList Utility::cardCodesFromNamePrefix(const QString &prefix, int maxResults)
+{
+    QMutexLocker locker(&cardsNameIndexMutex);
+    return cardsNameIndex.prefixCodes(prefix, maxResults);
+}
+
+
+QStringList Utility::cardCodesFromNameFuzzy(const QString &name, int maxResults, double minScore)
+{
+    QMutexLocker locker(&cardsNameIndexMutex);
+    return cardsNameIndex.fuzzyCodes(name, maxResults, minScore);
+}
+
+
+//Se construye al cargar cards.json, fuera del lock para no bloquear las busquedas del log
+void Utility::buildCardsNameIndex()
+{
+    CardNameIndex nameIndex;
+    nameIndex.build(*cardsJson);
+
+    QMutexLocker locker(&cardsNameIndexMutex);
+    cardsNameIndex = nameIndex;
+}
+
+
+void Utility::benchmarkCardsNameIndex()
+{
+    CardNameIndex nameIndex;
+    nameIndex.benchmark(*cardsJson);
+}
+
+
 QJsonValue Utility::getCardAttribute(QString code, QString attribute)
 {
     if(attribute == "text" || attribute == "name")
@@ -528,6 +606,52 @@ QString Utility::hscardsPath()
 }
 
 
+//Un solo escaneo del directorio, despues se mantiene con addCardImage/removeCardImage
+void Utility::buildCardImagesIndex()
+{
+    QMutexLocker locker(&cardImagesMutex);
+    scanCardImages();
+}
+
+
+//Requiere cardImagesMutex, asi no se pierden addCardImage durante el escaneo
+void Utility::scanCardImages()
+{
+    QDir dir(hscardsPath());
+    dir.setFilter(QDir::Files);
+    dir.setNameFilters(QStringList() << "*.png");
+
+    cardImagesIndex.clear();
+    for(const QString &file: dir.entryList())
+    {
+        cardImagesIndex.insert(file.left(file.length()-4));
+    }
+    cardImagesIndexBuilt = true;
+}
+
+
+bool Utility::cardImageExists(const QString &code)
+{
+    QMutexLocker locker(&cardImagesMutex);
+    if(!cardImagesIndexBuilt)   scanCardImages();
+    return cardImagesIndex.contains(code);
+}
+
+
+void Utility::addCardImage(const QString &code)
+{
+    QMutexLocker locker(&cardImagesMutex);
+    cardImagesIndex.insert(code);
+}
+
+
+void Utility::removeCardImage(const QString &code)
+{
+    QMutexLocker locker(&cardImagesMutex);
+    cardImagesIndex.remove(code);
+}
+
+
 QString Utility::extraPath()
 {
     return dataPath() + "/Extra";
@@ -546,6 +670,12 @@ void Utility::setCardsJson(QMap<QString, QJsonObject> *cardsJson)
 }
 
 
+bool Utility::isCardsJsonLoaded()
+{
+    return cardsJson != nullptr && !cardsJson->isEmpty();
+}
+
+
 void Utility::setLocalLang(QString localLang)
 {
     Utility::localLang = localLang;
@@ -554,73 +684,83 @@ void Utility::setLocalLang(QString localLang)
 
 QString Utility::removeAccents(QString s)
 {
-    if (diacriticLetters.isEmpty())
+    if(noDiacriticLetters.isEmpty())
     {
-        diacriticLetters = QString::fromUtf8("ŠŒŽšœžŸ¥µÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏÐÑÒÓÔÕÖØÙÚÛÜÝßàáâãäåæçèéêëìíîïðñòóôõöøùúûüýÿ");
-        noDiacriticLetters << "S"<<"OE"<<"Z"<<"s"<<"oe"<<"z"<<"Y"<<"Y"<<"u"<<"A"<<"A"<<"A"<<"A"<<"A"<<"A"<<"AE"<<"C"<<"E"<<"E"<<"E"<<"E"<<"I"<<"I"<<"I"<<"I"<<"D"<<"N"<<"O"<<"O"<<"O"<<"O"<<"O"<<"O"<<"U"<<"U"<<"U"<<"U"<<"Y"<<"s"<<"a"<<"a"<<"a"<<"a"<<"a"<<"a"<<"ae"<<"c"<<"e"<<"e"<<"e"<<"e"<<"i"<<"i"<<"i"<<"i"<<"o"<<"n"<<"o"<<"o"<<"o"<<"o"<<"o"<<"o"<<"u"<<"u"<<"u"<<"u"<<"y"<<"y";
+        QString diacriticLetters = QString::fromUtf8("ŠŒŽšœžŸ¥µÀÁÂÃÄÅÆÇÈÉÊËÌÍÎÏÐÑÒÓÔÕÖØÙÚÛÜÝßàáâãäåæçèéêëìíîïðñòóôõöøùúûüýÿ");
+        QStringList replacements;
+        replacements << "S"<<"OE"<<"Z"<<"s"<<"oe"<<"z"<<"Y"<<"Y"<<"u"<<"A"<<"A"<<"A"<<"A"<<"A"<<"A"<<"AE"<<"C"<<"E"<<"E"<<"E"<<"E"<<"I"<<"I"<<"I"<<"I"<<"D"<<"N"<<"O"<<"O"<<"O"<<"O"<<"O"<<"O"<<"U"<<"U"<<"U"<<"U"<<"Y"<<"s"<<"a"<<"a"<<"a"<<"a"<<"a"<<"a"<<"ae"<<"c"<<"e"<<"e"<<"e"<<"e"<<"i"<<"i"<<"i"<<"i"<<"o"<<"n"<<"o"<<"o"<<"o"<<"o"<<"o"<<"o"<<"u"<<"u"<<"u"<<"u"<<"y"<<"y";
+        for(int i=0; i<diacriticLetters.length(); i++)
+        {
+            if(!noDiacriticLetters.contains(diacriticLetters[i]))   noDiacriticLetters[diacriticLetters[i]] = replacements[i];
+        }
     }
 
-    QString output = "";
-    for (int i = 0; i < s.length(); i++)
+    QString output;
+    output.reserve(s.length());
+    for(const QChar &c: s)
     {
-        QChar c = s[i];
-        int dIndex = diacriticLetters.indexOf(c);
-        if (dIndex < 0)
-        {
-            output.append(c);
-        }
-        else
-        {
-            QString replacement = noDiacriticLetters[dIndex];
-            output.append(replacement);
-        }
+        QHash<QChar, QString>::const_iterator it = noDiacriticLetters.constFind(c);
+        if(it == noDiacriticLetters.constEnd())     output.append(c);
+        else                                        output.append(it.value());
     }
 
     return output;
 }
 
 
-std::vector<Point2f> Utility::findTemplateOnScreen(QString templateImage, QScreen *screen, std::vector<Point2f> templatePoints, QPointF &screenScale)
+//La plantilla se procesa una sola vez: lectura y SURF (keypoints + descriptores)
+QSharedPointer<const TemplateFeatures> Utility::getTemplateFeatures(const QString &templateImage)
 {
-    std::vector<Point2f> screenPoints;
-    QRect rect = screen->geometry();
-    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
-
-    //Screen scale
-    screenScale.setX(rect.width() / static_cast<qreal>(image.width()));
-    screenScale.setY(rect.height() / static_cast<qreal>(image.height()));
-
-    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<size_t>(image.bytesPerLine()));
-    cv::Mat screenCapture = mat.clone();
+    QMutexLocker locker(&templatesMutex);
+    if(templatesFeatures.contains(templateImage))   return templatesFeatures[templateImage];
 
-    Mat img_object = imread((Utility::extraPath() + "/" + templateImage).toStdString(), CV_LOAD_IMAGE_GRAYSCALE );
-    if(!img_object.data)
+    QSharedPointer<TemplateFeatures> features(new TemplateFeatures());
+    features->image = imread((Utility::extraPath() + "/" + templateImage).toStdString(), CV_LOAD_IMAGE_GRAYSCALE );
+    if(!features->image.data)
     {
         qDebug() << "Utility: Cannot find" << templateImage;
-        return screenPoints;
+        return QSharedPointer<const TemplateFeatures>();
     }
-    Mat img_scene;
-    cv::cvtColor(screenCapture, img_scene, CV_BGR2GRAY);
+
+    int minHessian = 400;
+    SurfFeatureDetector detector( minHessian );
+    detector.detect( features->image, features->keypoints );
+    SurfDescriptorExtractor extractor;
+    extractor.compute( features->image, features->keypoints, features->descriptors );
+
+    qDebug() << "Utility: Template" << templateImage << "keypoints:" << features->keypoints.size();
+    templatesFeatures[templateImage] = features;
+    return features;
+}
+
+
+//Homografia plantilla --> img_scene. Vacia si no hay suficientes keypoints buenos.
+Mat Utility::findTemplateHomography(const TemplateFeatures &features, const Mat &img_scene, int &numGoodMatches)
+{
+    numGoodMatches = 0;
+    const std::vector<KeyPoint> &keypoints_object = features.keypoints;
+    const Mat &descriptors_object = features.descriptors;
 
     //-- Step 1: Detect the keypoints using SURF Detector
     int minHessian = 400;
 
     SurfFeatureDetector detector( minHessian );
 
-    std::vector<KeyPoint> keypoints_object, keypoints_scene;
+    std::vector<KeyPoint> keypoints_scene;
 
-    detector.detect( img_object, keypoints_object );
     detector.detect( img_scene, keypoints_scene );
 
     //-- Step 2: Calculate descriptors (feature vectors)
     SurfDescriptorExtractor extractor;
 
-    Mat descriptors_object, descriptors_scene;
+    Mat descriptors_scene;
 
-    extractor.compute( img_object, keypoints_object, descriptors_object );
     extractor.compute( img_scene, keypoints_scene, descriptors_scene );
+    if(descriptors_scene.empty() || descriptors_object.empty())     return Mat();
 
     //-- Step 3: Matching descriptor vectors using FLANN matcher
+    //Para cada keypoint de la plantilla su vecino mas cercano en la escena.
+    //El indice se construye sobre la escena en cada llamada (matcher local, sin estado compartido entre hilos).
     FlannBasedMatcher matcher;
     std::vector< DMatch > matches;
     matcher.match( descriptors_object, descriptors_scene, matches );
@@ -643,7 +783,8 @@ std::vector<Point2f> Utility::findTemplateOnScreen(QString templateImage, QScree
        { good_matches.push_back( matches[static_cast<ulong>(i)]); }
     }
     qDebug()<< "Utility: FLANN Keypoints buenos:" <<good_matches.size();
-    if(good_matches.size() < 10)    return screenPoints;
+    numGoodMatches = static_cast<int>(good_matches.size());
+    if(good_matches.size() < 10)    return Mat();
 
 
     //-- Localize the object (find homography)
@@ -659,19 +800,137 @@ std::vector<Point2f> Utility::findTemplateOnScreen(QString templateImage, QScree
 
     Mat H = findHomography( obj, scene, CV_RANSAC );
 
-    //-- Get the corners from the image_1 ( the object to be "detected" )
-    perspectiveTransform(templatePoints, screenPoints, H);
-
     //Show matches
     if(false)
     {
         Mat img_matches;
-        drawMatches( img_object, keypoints_object, img_scene, keypoints_scene,
+        drawMatches( features.image, keypoints_object, img_scene, keypoints_scene,
                      good_matches, img_matches, Scalar::all(-1), Scalar::all(-1),
                      vector<char>(), DrawMatchesFlags::NOT_DRAW_SINGLE_POINTS );
         imshow( "Good Matches & Object detection", img_matches );
     }
 
+    return H;
+}
+
+
+//En pantallas grandes buscamos la plantilla en la escena reducida a TEMPLATE_SCENE_MAX_HEIGHT
+//y refinamos la homografia en el recorte de resolucion completa donde se ha encontrado.
+std::vector<Point2f> Utility::findTemplateOnScreen(QString templateImage, QScreen *screen, std::vector<Point2f> templatePoints, QPointF &screenScale)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QRect rect = screen->geometry();
+    QImage image = screen->grabWindow(0,rect.x(),rect.y(),rect.width(),rect.height()).toImage();
+
+    //Screen scale
+    screenScale.setX(rect.width() / static_cast<qreal>(image.width()));
+    screenScale.setY(rect.height() / static_cast<qreal>(image.height()));
+
+    cv::Mat mat(image.height(),image.width(),CV_8UC4,image.bits(), static_cast<size_t>(image.bytesPerLine()));
+    qDebug()<< "Utility: Screen grab:" << timer.elapsed() << "ms";
+
+    return findTemplateOnImage(templateImage, mat, templatePoints);
+}
+
+
+//mat BGR o BGRA (captura de pantalla o screenshot guardado)
+std::vector<Point2f> Utility::findTemplateOnImage(const QString &templateImage, const Mat &mat, const std::vector<Point2f> &templatePoints)
+{
+    std::vector<Point2f> screenPoints;
+    QElapsedTimer timer;
+    timer.start();
+
+    QSharedPointer<const TemplateFeatures> features = getTemplateFeatures(templateImage);
+    if(features.isNull())   return screenPoints;
+
+    Mat img_scene;
+    cv::cvtColor(mat, img_scene, (mat.channels() == 4)?CV_BGRA2GRAY:CV_BGR2GRAY);
+    const qint64 grayTime = timer.restart();
+
+    int numGoodMatches;
+    const double scale = std::min(1.0, TEMPLATE_SCENE_MAX_HEIGHT / static_cast<double>(img_scene.rows));
+    Mat H;
+    qint64 coarseTime = 0, refineTime = 0;
+    double refineShift = 0;
+
+    if(scale >= 1.0)
+    {
+        H = findTemplateHomography(*features, img_scene, numGoodMatches);
+        coarseTime = timer.restart();
+    }
+    else
+    {
+        Mat img_small;
+        cv::resize(img_scene, img_small, Size(), scale, scale, INTER_AREA);
+        Mat H_small = findTemplateHomography(*features, img_small, numGoodMatches);
+        coarseTime = timer.restart();
+        if(H_small.empty())
+        {
+            qDebug()<< "Utility: Template search" << img_scene.cols << "x" << img_scene.rows << "scale" << scale <<
+                       "- Not found. Gray:" << grayTime << "ms Coarse:" << coarseTime << "ms";
+            return screenPoints;
+        }
+
+        //Plantilla --> escena completa
+        Mat S = Mat::eye(3, 3, CV_64F);
+        S.at<double>(0,0) = S.at<double>(1,1) = 1/scale;
+        H = S * H_small;
+
+        //Region de la plantilla en resolucion completa (+ margen)
+        std::vector<Point2f> templateCorners(4), sceneCorners;
+        templateCorners[0] = Point2f(0, 0);
+        templateCorners[1] = Point2f(static_cast<float>(features->image.cols), 0);
+        templateCorners[2] = Point2f(static_cast<float>(features->image.cols), static_cast<float>(features->image.rows));
+        templateCorners[3] = Point2f(0, static_cast<float>(features->image.rows));
+        perspectiveTransform(templateCorners, sceneCorners, H);
+        Rect region = boundingRect(sceneCorners);
+        const int marginX = static_cast<int>(region.width * TEMPLATE_REFINE_MARGIN);
+        const int marginY = static_cast<int>(region.height * TEMPLATE_REFINE_MARGIN);
+        region = Rect(region.x - marginX, region.y - marginY, region.width + 2*marginX, region.height + 2*marginY);
+        region &= Rect(0, 0, img_scene.cols, img_scene.rows);
+
+        if(region.area() > 0)
+        {
+            int numRefineMatches;
+            Mat H_region = findTemplateHomography(*features, img_scene(region), numRefineMatches);
+            if(!H_region.empty())
+            {
+                Mat T = Mat::eye(3, 3, CV_64F);
+                T.at<double>(0,2) = region.x;
+                T.at<double>(1,2) = region.y;
+                Mat H_refined = T * H_region;
+
+                //Desplazamiento medio de las esquinas respecto a la estimacion reducida
+                std::vector<Point2f> refinedCorners;
+                perspectiveTransform(templateCorners, refinedCorners, H_refined);
+                for(uint i=0; i<refinedCorners.size(); i++)
+                {
+                    refineShift += norm(refinedCorners[i] - sceneCorners[i]) / refinedCorners.size();
+                }
+
+                H = H_refined;
+                numGoodMatches = numRefineMatches;
+            }
+        }
+        refineTime = timer.restart();
+    }
+
+    if(H.empty())
+    {
+        qDebug()<< "Utility: Template search" << img_scene.cols << "x" << img_scene.rows << "scale" << scale <<
+                   "- Not found. Gray:" << grayTime << "ms Search:" << coarseTime << "ms";
+        return screenPoints;
+    }
+
+    //-- Get the corners from the image_1 ( the object to be "detected" )
+    perspectiveTransform(templatePoints, screenPoints, H);
+
+    qDebug()<< "Utility: Template search" << img_scene.cols << "x" << img_scene.rows << "scale" << scale <<
+               "- Found (" << numGoodMatches << "keypoints). Gray:" << grayTime << "ms Coarse:" << coarseTime <<
+               "ms Refine:" << refineTime << "ms Refine shift:" << refineShift << "px";
+
     return screenPoints;
 }
 
@@ -1002,8 +1261,17 @@ void Utility::checkTierlistsCount()
         {
             QString code = Utility::cardEnCodeFromName(name);
             if(code.isEmpty())  code = Utility::cardEnCodeFromName(name, false);
-            if(code.isEmpty())  qDebug()<<"HearthArena wrong name:"<<name;
-            else                haCodes.append(code);
+            if(code.isEmpty())
+            {
+                QStringList fuzzyCodes = Utility::cardCodesFromNameFuzzy(name, 1);
+                if(fuzzyCodes.isEmpty())    qDebug()<<"HearthArena wrong name:"<<name;
+                else
+                {
+                    code = fuzzyCodes.first();
+                    qDebug()<<"HearthArena wrong name:"<<name<<"--> Closest:"<<code<<Utility::cardEnNameFromCode(code);
+                }
+            }
+            if(!code.isEmpty()) haCodes.append(code);
         }
 
         qDebug()<<heroString<<"LightForge count:"<<lfCodes.count();
@@ -2,10 +2,15 @@
 #define UTILITY_H
 
 #include "Cards/deckcard.h"
+#include "Synergies/cardtags.h"
 #include "opencv2/opencv.hpp"
 #include "Utils/libzippp.h"
+#include "Utils/cardnameindex.h"
 #include <QString>
 #include <QMap>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
 #include <QJsonObject>
 #include <QUrlQuery>
 #include <QNetworkRequest>
@@ -25,6 +30,8 @@ using namespace cv;
 #define SHOW_EASING_CURVE QEasingCurve::OutCubic
 #define HIDE_EASING_CURVE QEasingCurve::InCubic
 #define NUM_HEROS 10
+#define TEMPLATE_SCENE_MAX_HEIGHT 1080
+#define TEMPLATE_REFINE_MARGIN 0.1
 
 enum DebugLevel { Normal, Warning, Error };
 enum Transparency { Transparent, AutoTransparent, Opaque, Framed };
@@ -55,6 +62,16 @@ enum VisibleMechanics {V_AOE, V_TAUNT, V_TAUNT_ALL,
 //New Synergy Step 1
 
 
+//Keypoints y descriptores de una plantilla de findTemplateOnScreen
+class TemplateFeatures
+{
+public:
+    Mat image;
+    std::vector<KeyPoint> keypoints;
+    Mat descriptors;
+};
+
+
 class GameResultPost
 {
 public:
@@ -73,13 +90,25 @@ public:
 //Variables
 private:
     static QMap<QString, QJsonObject> *cardsJson;
+    static QHash<QString, CardRuleData> cardsRuleData;
+    static CardNameIndex cardsNameIndex;
+    static QMutex cardsNameIndexMutex;
+    static QSet<QString> cardImagesIndex;
+    static bool cardImagesIndexBuilt;
+    static QMutex cardImagesMutex;
+    static QMap<QString, QSharedPointer<const TemplateFeatures>> templatesFeatures;
+    static QMutex templatesMutex;
     static QString localLang;
-    static QString diacriticLetters;
-    static QStringList noDiacriticLetters;
+    static QHash<QChar, QString> noDiacriticLetters;
 
 
 //Metodos
+private:
+    static void scanCardImages();
+
 public:
+    static CardClass parseClassLogNumber(const QString &hero);
+    static bool isValidHeroClass(CardClass cardClass);
     static QString className2classLogNumber(const QString &hero);
     static QString classEnum2classLogNumber(CardClass cardClass);
     static QString classEnum2classUName(CardClass cardClass);
@@ -97,17 +126,29 @@ public:
     static QString dataPath();
     static QString gameslogPath();
     static QString hscardsPath();
+    static void buildCardImagesIndex();
+    static bool cardImageExists(const QString &code);
+    static void addCardImage(const QString &code);
+    static void removeCardImage(const QString &code);
     static QString extraPath();
     static QString cardEnNameFromCode(QString code);
     static QString cardEnCodeFromName(QString name, bool onlyCollectible=true);
     static QString cardLocalCodeFromName(QString name);
+    static QStringList cardCodesFromNamePrefix(const QString &prefix, int maxResults=20);
+    static QStringList cardCodesFromNameFuzzy(const QString &name, int maxResults=10, double minScore=NAMEINDEX_FUZZY_MIN_SCORE);
+    static void buildCardsNameIndex();
+    static void benchmarkCardsNameIndex();
     static void setCardsJson(QMap<QString, QJsonObject> *cardsJson);
+    static bool isCardsJsonLoaded();
     static void setLocalLang(QString localLang);
     static QString removeAccents(QString s);
     static QPropertyAnimation *fadeInWidget(QWidget *widget);
     static QPropertyAnimation *fadeOutWidget(QWidget *widget);
     static QString getLoadingScreenToString(LoadingScreenState loadingScreen);
     static LoadingScreenState getLoadingScreenFromString(QString loadingScreenString);
+    static QSharedPointer<const TemplateFeatures> getTemplateFeatures(const QString &templateImage);
+    static Mat findTemplateHomography(const TemplateFeatures &features, const Mat &img_scene, int &numGoodMatches);
+    static std::vector<Point2f> findTemplateOnImage(const QString &templateImage, const Mat &mat, const std::vector<Point2f> &templatePoints);
     static std::vector<Point2f> findTemplateOnScreen(QString templateImage, QScreen *screen, std::vector<Point2f> templatePoints, QPointF &screenScale);
     static QPixmap getTransformedImage(QPixmap image, QPointF pos, QPointF anchor, qreal rot, QPointF &origin);
     static bool isLeftOfScreen(QPoint center);
@@ -123,6 +164,8 @@ public:
     static QString themesPath();
     static int classLogNumber2classOrder(QString heroLog);
     static QString cardEnTextFromCode(QString code);
+    static void buildCardsRuleData();
+    static const CardRuleData &getCardRuleData(const QString &code);
     static void clearLayout(QLayout *layout, bool deleteWidgets);
     static void showItemsLayout(QLayout *layout);
     static QStringList getSetCodes(const QString &set, bool onlyCollectible=true);